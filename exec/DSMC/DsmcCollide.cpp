@@ -87,8 +87,7 @@ void FhdParticleContainer::CalcSelections(Real dt)
         const Array4<Real> & arrvrmax = mfvrmax.array(mfi);
         const Array4<Real> & arrselect = mfselect.array(mfi);
 
-        auto inds = m_bins.permutationPtr();
-        auto offs = m_bins.offsetsPtr();
+        const DsmcBinsView bins = getBins();
 
         Real ocollisionCellVolTmp = ocollisionCellVol;
         Real particle_neff_tmp = particle_neff;
@@ -118,8 +117,8 @@ void FhdParticleContainer::CalcSelections(Real dt)
                     getSpeciesIndexRet(i_spec,j_spec,&ij_spec);
                     //np_i = m_cell_vectors[i_spec][grid_id][imap].size();
                     //np_j = m_cell_vectors[j_spec][grid_id][imap].size();
-                    np_i = getBinSize(offs,iv,i_spec,tile_box);
-                    np_j = getBinSize(offs,iv,j_spec,tile_box);
+                    np_i = getBinSize(bins,iv,i_spec,tile_box);
+                    np_j = getBinSize(bins,iv,j_spec,tile_box);
                     vrmax = arrvrmax(i,j,k,ij_spec);
                     crossSection = csx[ij_spec];
                     //crossSection = 0;
@@ -152,8 +151,7 @@ void FhdParticleContainer::CollideParticles(Real dt)
         const Array4<Real> & arrvrmax = mfvrmax.array(mfi);
         const Array4<Real> & arrselect = mfselect.array(mfi);
 
-        auto inds = m_bins.permutationPtr();
-        auto offs = m_bins.offsetsPtr();
+        const DsmcBinsView bins = getBins();
 
 
         IntVect smallEnd = tile_box.smallEnd();
@@ -192,7 +190,7 @@ void FhdParticleContainer::CollideParticles(Real dt)
 
             for(int i=0;i<nspecies;i++)
             {
-                specLists[i] = getCellList(inds,offs,iv,i,tile_box);
+                specLists[i] = getCellList(bins,iv,i,tile_box);
             }
 
             totalSel = 0;
@@ -200,7 +198,7 @@ void FhdParticleContainer::CollideParticles(Real dt)
             for(int i_spec = 0; i_spec<nspecies; i_spec++)
             {
                 //np[i_spec] = m_cell_vectors[i_spec][grid_id][imap].size();
-                np[i_spec] = getBinSize(offs,iv,i_spec,tile_box);
+                np[i_spec] = getBinSize(bins,iv,i_spec,tile_box);
                 for (int j_spec = i_spec; j_spec < nspecies; j_spec++)
                 {
                     //ij_spec = getSpeciesIndex(i_spec,j_spec);
@@ -253,8 +251,8 @@ void FhdParticleContainer::CollideParticles(Real dt)
                 vrmax = arrvrmax(i,j,k,specij);
                 //pindxi = (int)floor(amrex::Random()*m_cell_vectors[speci][grid_id][imap].size());
                 //pindxj = (int)floor(amrex::Random()*m_cell_vectors[specj][grid_id][imap].size());
-                pindxi = (int)floor(amrex::Random(engine)*getBinSize(offs,iv,speci,tile_box));
-                pindxj = (int)floor(amrex::Random(engine)*getBinSize(offs,iv,specj,tile_box));
+                pindxi = (int)floor(amrex::Random(engine)*getBinSize(bins,iv,speci,tile_box));
+                pindxj = (int)floor(amrex::Random(engine)*getBinSize(bins,iv,specj,tile_box));
                 pindxi = specLists[speci][pindxi];
                 pindxj = specLists[specj][pindxj];
                 //pindxi = m_cell_vectors[speci][grid_id][imap][pindxi];
@@ -318,6 +316,159 @@ void FhdParticleContainer::CollideParticles(Real dt)
     }
 }
 
+// NTC collisions from a flat candidate list (dsmc_collide_type = 1)
+// The candidates of all cells are counted from mfselect and laid out by a prefix sum.
+// Each cell's segment holds its pair types in a random order, which is the same as
+// drawing them one by one without replacement in CollideParticles. The candidates are
+// then processed in rounds: round r does the r-th candidate of every cell in parallel,
+// so the collisions within a cell keep their sequential order.
+void FhdParticleContainer::CollideParticlesCandidates(Real dt)
+{
+    BL_PROFILE_VAR("CollideParticlesCandidates()",CollideParticlesCandidates);
+    int lev = 0;
+    for(MFIter mfi(mfvrmax); mfi.isValid(); ++mfi)
+    {
+        const Box& tile_box  = mfi.tilebox();
+        const int grid_id = mfi.index();
+        const int tile_id = mfi.LocalTileIndex();
+        auto& particle_tile = GetParticles(lev)[std::make_pair(grid_id,tile_id)];
+        auto& aos = particle_tile.GetArrayOfStructs();
+        ParticleType* particles = aos().dataPtr();
+
+        const Array4<Real> & arrvrmax = mfvrmax.array(mfi);
+        const Array4<Real> & arrselect = mfselect.array(mfi);
+
+        const DsmcBinsView bins = getBins();
+
+        const int nspec = nspecies;
+        const int ncells = tile_box.numPts();
+
+        Real mass[MAX_SPECIES];
+
+        for(int i=0;i<(nspecies);i++)
+        {
+            mass[i] = properties[i].mass;
+        }
+
+        // number of candidates in each cell and their offsets in the flat list
+        Gpu::DeviceVector<int> cand_count(ncells);
+        Gpu::DeviceVector<int> cand_offset(ncells);
+        int* pcount = cand_count.dataPtr();
+        int* poffset = cand_offset.dataPtr();
+
+        amrex::ParallelFor(tile_box,[=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept {
+            long imap = tile_box.index(IntVect(i,j,k));
+            int ij_spec;
+            int nc = 0;
+            for(int i_spec = 0; i_spec<nspec; i_spec++)
+            {
+                for (int j_spec = i_spec; j_spec < nspec; j_spec++)
+                {
+                    getSpeciesIndexRet(i_spec,j_spec, &ij_spec);
+                    nc += (int)arrselect(i,j,k,ij_spec);
+                }
+            }
+            pcount[imap] = nc;
+        });
+
+        const int ncand = Scan::ExclusiveSum(ncells, pcount, poffset);
+        if (ncand == 0) continue;
+
+        const int nrounds = Reduce::Max(ncells, pcount);
+
+        // pair type (ij_spec) of every candidate, shuffled within each cell (Fisher-Yates)
+        Gpu::DeviceVector<int> cand_pair(ncand);
+        int* ppair = cand_pair.dataPtr();
+
+        amrex::ParallelForRNG(tile_box,[=] AMREX_GPU_DEVICE (int i, int j, int k, amrex::RandomEngine const& engine) noexcept {
+            long imap = tile_box.index(IntVect(i,j,k));
+            int* seg = ppair + poffset[imap];
+            int ij_spec;
+            int n = 0;
+            for(int i_spec = 0; i_spec<nspec; i_spec++)
+            {
+                for (int j_spec = i_spec; j_spec < nspec; j_spec++)
+                {
+                    getSpeciesIndexRet(i_spec,j_spec, &ij_spec);
+                    const int nsel = (int)arrselect(i,j,k,ij_spec);
+                    for (int m = 0; m < nsel; m++) { seg[n++] = ij_spec; }
+                }
+            }
+            for (int m = n-1; m > 0; m--)
+            {
+                int r = amrex::min((int)(amrex::Random(engine)*(m+1)), m);
+                int tmp = seg[m]; seg[m] = seg[r]; seg[r] = tmp;
+            }
+        });
+
+        for (int irnd = 0; irnd < nrounds; irnd++)
+        {
+            amrex::ParallelForRNG(tile_box,[=] AMREX_GPU_DEVICE (int i, int j, int k, amrex::RandomEngine const& engine) noexcept {
+                const IntVect iv = {i,j,k};
+                long imap = tile_box.index(iv);
+                if (irnd >= pcount[imap]) return;
+
+                // ij_spec = specj + nspecies*speci with speci <= specj
+                const int specij = ppair[poffset[imap]+irnd];
+                const int speci = specij / nspec;
+                const int specj = specij % nspec;
+
+                Real massi = mass[speci];
+                Real massj = mass[specj];
+                Real massij = massi + massj;
+                Real vrmax = arrvrmax(i,j,k,specij);
+
+                int pindxi = (int)floor(amrex::Random(engine)*getBinSize(bins,iv,speci,tile_box));
+                int pindxj = (int)floor(amrex::Random(engine)*getBinSize(bins,iv,specj,tile_box));
+                pindxi = getCellList(bins,iv,speci,tile_box)[pindxi];
+                pindxj = getCellList(bins,iv,specj,tile_box)[pindxj];
+
+                ParticleType & parti = particles[pindxi];
+                ParticleType & partj = particles[pindxj];
+
+                RealVect vi, vj, vij, eij, vreij;
+
+                vi[0] = parti.rdata(FHD_realData::velx);
+                vi[1] = parti.rdata(FHD_realData::vely);
+                vi[2] = parti.rdata(FHD_realData::velz);
+
+                vj[0] = partj.rdata(FHD_realData::velx);
+                vj[1] = partj.rdata(FHD_realData::vely);
+                vj[2] = partj.rdata(FHD_realData::velz);
+
+                vij[0] = vi[0]-vj[0]; vij[1] = vi[1]-vj[1]; vij[2] = vi[2]-vj[2];
+                Real vrmag = sqrt(vij[0]*vij[0]+vij[1]*vij[1]+vij[2]*vij[2]);
+                if(vrmag>vrmax) {vrmax = vrmag; arrvrmax(i,j,k,specij) = 1.1*vrmax;}
+
+                // isotropic direction: cos(phi) uniform in [-1,1], already unit length
+                Real theta = 2.0*M_PI*amrex::Random(engine);
+                Real cosphi = 1.0-2.0*amrex::Random(engine);
+                Real sinphi = sqrt(amrex::max(0.0, 1.0-cosphi*cosphi));
+                eij[0] = sinphi*std::cos(theta);
+                eij[1] = sinphi*std::sin(theta);
+                eij[2] = cosphi;
+
+                Real vreijmag = vij[0]*eij[0]+vij[1]*eij[1]+vij[2]*eij[2];
+                if(vrmag>vrmax*amrex::Random(engine))
+                {
+                    vreijmag = vreijmag*2.0/massij;
+                    vreij[0] = vreijmag*eij[0];
+                    vreij[1] = vreijmag*eij[1];
+                    vreij[2] = vreijmag*eij[2];
+
+                    parti.rdata(FHD_realData::velx) = vi[0] - vreij[0]*massj;
+                    parti.rdata(FHD_realData::vely) = vi[1] - vreij[1]*massj;
+                    parti.rdata(FHD_realData::velz) = vi[2] - vreij[2]*massj;
+                    partj.rdata(FHD_realData::velx) = vj[0] + vreij[0]*massi;
+                    partj.rdata(FHD_realData::vely) = vj[1] + vreij[1]*massi;
+                    partj.rdata(FHD_realData::velz) = vj[2] + vreij[2]*massi;
+                }
+            });
+        }
+        Gpu::synchronize();
+    }
+}
+
 void FhdParticleContainer::CollideParticles2(Real dt)
 {
     BL_PROFILE_VAR("CollideParticles()",CollideParticles);
@@ -216,6 +216,10 @@ void main_driver(const char* argv)
     paramPlane paramPlaneList[paramPlaneCount];
     BuildParamplanes(paramPlaneList,paramPlaneCount,realDomain.lo(),realDomain.hi());
 
+    // candidate planes of each cell, so that moves only test nearby planes
+    iMultiFab planeCell;
+    BuildPlaneCellIndex(paramPlaneList,paramPlaneCount,geom,ba,dmap,planeCell);
+
     // Particle tile size
     Vector<int> ts(BL_SPACEDIM);
 
@@ -332,7 +336,11 @@ void main_driver(const char* argv)
         tbegin = ParallelDescriptor::second();
 
         particles.CalcSelections(dt);
-        particles.CollideParticles(dt);
+        if (dsmc_collide_type == 1) {
+            particles.CollideParticlesCandidates(dt);
+        } else {
+            particles.CollideParticles(dt);
+        }
 
 //      if(istep%2!=0)
         if(false)
@@ -363,7 +371,7 @@ void main_driver(const char* argv)
 
         //particles.externalForce(dt);
         particles.Source(dt, paramPlaneList, paramPlaneCount, cuInst);
-        particles.MoveParticlesCPP(dt, paramPlaneList, paramPlaneCount);
+        particles.MoveParticlesCPP(dt, paramPlaneList, paramPlaneCount, &planeCell);
         //particles.updateTimeStep(geom,dt);
                 //reduceMassFlux(paramPlaneList, paramPlaneCount);
 
@@ -99,8 +99,7 @@ void FhdParticleContainer::EvaluateStats(MultiFab& mfcuInst,
 
         Real ocollisionCellVolTmp = ocollisionCellVol;
 
-        auto inds = m_bins.permutationPtr();
-        auto offs = m_bins.offsetsPtr();
+        const DsmcBinsView bins = getBins();
         //////////////////////////////////////
         // Primitve and Conserved Instantaneous Values
         //////////////////////////////////////
@@ -114,8 +113,8 @@ void FhdParticleContainer::EvaluateStats(MultiFab& mfcuInst,
 
 
             for (int l=0; l<nspecies; l++) {
-                unsigned int np_spec = getBinSize(offs,iv,l,tile_box);
-                unsigned int* cellList = getCellList(inds,offs,iv,l,tile_box);
+                unsigned int np_spec = getBinSize(bins,iv,l,tile_box);
+                unsigned int* cellList = getCellList(bins,iv,l,tile_box);
                 //long np_spec2 = m_cell_vectors[l][grid_id][imap].size();
 //
                 //                //cout << "old: " << np_spec2 << ", new: " << np_spec << endl;
@@ -222,8 +221,8 @@ void FhdParticleContainer::EvaluateStats(MultiFab& mfcuInst,
 
             for (int l=nspecies-1; l>=0; l--) {
                 //long np_spec = m_cell_vectors[l][grid_id][imap].size();
-                unsigned int np_spec = getBinSize(offs,iv,l,tile_box);
-                unsigned int* cellList = getCellList(inds,offs,iv,l,tile_box);
+                unsigned int np_spec = getBinSize(bins,iv,l,tile_box);
+                unsigned int* cellList = getCellList(bins,iv,l,tile_box);
                 for (int m=0; m<np_spec; m++) {
                     //int pind = m_cell_vectors[l][grid_id][imap][m];
                     int pind = cellList[m];
@@ -251,8 +250,8 @@ void FhdParticleContainer::EvaluateStats(MultiFab& mfcuInst,
 
             for (int l=nspecies-1; l>=0; l--) {
                 //long np_spec = m_cell_vectors[l][grid_id][imap].size();
-                unsigned int np_spec = getBinSize(offs,iv,l,tile_box);
-                unsigned int* cellList = getCellList(inds,offs,iv,l,tile_box);
+                unsigned int np_spec = getBinSize(bins,iv,l,tile_box);
+                unsigned int* cellList = getCellList(bins,iv,l,tile_box);
                 for (int m=0; m<np_spec; m++) {
                     //int pind = m_cell_vectors[l][grid_id][imap][m];
                     int pind = cellList[m];
@@ -406,8 +405,8 @@ void FhdParticleContainer::EvaluateStats(MultiFab& mfcuInst,
             int specTotal = 0;
             for (int l=nspecies-1; l>=0; l--) {
                 //long np_spec = m_cell_vectors[l][grid_id][imap].size();
-                unsigned int np_spec = getBinSize(offs,iv,l,tile_box);
-                unsigned int* cellList = getCellList(inds,offs,iv,l,tile_box);
+                unsigned int np_spec = getBinSize(bins,iv,l,tile_box);
+                unsigned int* cellList = getCellList(bins,iv,l,tile_box);
                 for (int m=0; m<np_spec; m++) {
                     //int pind = m_cell_vectors[l][grid_id][imap][m];
                     int pind = cellList[m];
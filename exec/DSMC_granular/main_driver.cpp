@@ -197,6 +197,10 @@ void main_driver(const char* argv)
     paramPlane paramPlaneList[paramPlaneCount];
     BuildParamplanes(paramPlaneList,paramPlaneCount,realDomain.lo(),realDomain.hi());
 
+    // candidate planes of each cell, so that moves only test nearby planes
+    iMultiFab planeCell;
+    BuildPlaneCellIndex(paramPlaneList,paramPlaneCount,geom,ba,dmap,planeCell);
+
     // Particle tile size
     Vector<int> ts(BL_SPACEDIM);
 
@@ -322,7 +326,7 @@ void main_driver(const char* argv)
         particles.CollideParticles(dt);
         particles.Source(dt, paramPlaneList, paramPlaneCount);
         //particles.externalForce(dt);
-        particles.MoveParticlesCPP(dt, paramPlaneList, paramPlaneCount);
+        particles.MoveParticlesCPP(dt, paramPlaneList, paramPlaneCount, &planeCell);
         //particles.updateTimeStep(geom,dt);
 
         //////////////////////////////////////
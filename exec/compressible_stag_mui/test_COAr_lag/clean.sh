@@ -0,0 +1,3 @@
+#!/bin/bash
+
+rm -rf sync lag* Backtrace*
@@ -0,0 +1,95 @@
+#!/bin/bash
+
+# checks the pipelined FHD-KMC coupling (mui_lag) on one FHD and one KMC process
+# 1) sync: reference run with $REF_EXEC, an fhd executable built from a tree
+#    without mui_lag (synchronous mui_push/mui_fetch); required
+# 2) lag0: mui_lag = 0, must reproduce sync exactly
+# 3) lag1: mui_lag = 1, must agree with sync to relative tolerance $LAG_TOL
+#    (default 1e-2) in every plotfile component, checked with $FCOMPARE
+#    (amrex/Tools/Plotfile/fcompare)
+
+SPKSCR=in.kmc
+FHDSCR=inputs_fhd_stag
+SPKSEED=12345
+LAG_TOL=${LAG_TOL:-1e-2}
+FCOMPARE=${FCOMPARE:-fcompare}
+
+# check kmc executable
+exec1=../SPPARKS_MUI/spk_mui
+if [ ! -f $exec1 ]
+then
+  echo "ERROR: kmc executable $exec1 not found"
+  exit 1
+fi
+
+# check fhd executable
+exec2=../main3d.gnu.MPI.ex
+if [ ! -f $exec2 ]
+then
+  echo "ERROR: fhd executable $exec2 not found"
+  exit 1
+fi
+# check reference executable
+if [ -z "$REF_EXEC" ]
+then
+  echo "ERROR: REF_EXEC not set; point it to an fhd executable built without mui_lag"
+  exit 1
+fi
+if [ ! -f $REF_EXEC ]
+then
+  echo "ERROR: reference executable $REF_EXEC not found"
+  exit 1
+fi
+
+# check plotfile comparison tool
+if ! command -v $FCOMPARE > /dev/null
+then
+  echo "ERROR: plotfile comparison tool $FCOMPARE not found; set FCOMPARE"
+  exit 1
+fi
+
+exec_ref=`realpath $REF_EXEC`
+exec1=`realpath $exec1`
+exec2=`realpath $exec2`
+
+# run one coupled case in directory $1 with fhd executable $2 and extra fhd arguments
+run_case() {
+  dir=$1; fhd=$2; shift 2
+  rm -rf $dir && mkdir $dir
+  cp $SPKSCR $FHDSCR $dir
+  (cd $dir && mpirun -np 1 $exec1 -var SEED $SPKSEED -screen none < $SPKSCR : -np 1 $fhd $FHDSCR "$@" > log.fhd)
+}
+
+run_case sync $exec_ref
+run_case lag0 $exec2 mui_lag=0
+run_case lag1 $exec2 mui_lag=1
+
+# lag0 plotfiles must be identical to sync apart from the job info (run time, date),
+# lag1 plotfiles must agree with sync to LAG_TOL
+status=0
+pltfiles=`cd sync && ls -d plt* 2> /dev/null`
+if [ -z "$pltfiles" ]
+then
+  echo "ERROR: reference run wrote no plotfiles"
+  exit 1
+fi
+for pltfile in $pltfiles
+do
+  if diff -r -x job_info sync/$pltfile lag0/$pltfile > /dev/null
+  then
+    echo "$pltfile: lag0 matches sync"
+  else
+    echo "$pltfile: lag0 DIFFERS from sync"
+    status=1
+  fi
+
+  if $FCOMPARE -r $LAG_TOL sync/$pltfile lag1/$pltfile > lag1/fcompare.$pltfile.log
+  then
+    echo "$pltfile: lag1 agrees with sync to relative tolerance $LAG_TOL"
+  else
+    echo "$pltfile: lag1 DIFFERS from sync by more than relative tolerance $LAG_TOL (see lag1/fcompare.$pltfile.log)"
+    status=1
+  fi
+done
+
+exit $status
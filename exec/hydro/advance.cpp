@@ -27,7 +27,7 @@ void advance(std::array< MultiFab, AMREX_SPACEDIM >& umac,
 
   const Real* dx = geom.CellSize();
   const Real dtinv = 1.0/dt;
-  Real norm_pre_rhs;
+  Real norm_pre_rhs = 0.;
 
   Real theta_alpha = (algorithm_type == 1) ? 0. : 1.;
 
@@ -133,11 +133,19 @@ void advance(std::array< MultiFab, AMREX_SPACEDIM >& umac,
 
   Real gmres_abs_tol_in = gmres_abs_tol; // save this
 
-  // call GMRES to compute predictor
+  // periodic with constant coefficients: exact solves in Fourier space
+  const bool use_fft = StokesFFTAvailable(alpha_fc,beta,beta_ed,theta_alpha,geom);
+
+  // compute predictor
   GMRES gmres(ba,dmap,geom);
-  gmres.Solve(gmres_rhs_u,gmres_rhs_p,umacNew,pres,
-              alpha_fc,beta,beta_ed,gamma,
-              theta_alpha,geom,norm_pre_rhs);
+  if (use_fft) {
+      StokesFFTSolve(gmres_rhs_u,gmres_rhs_p,umacNew,pres,alpha_fc,beta,theta_alpha,geom);
+  }
+  else {
+      gmres.Solve(gmres_rhs_u,gmres_rhs_p,umacNew,pres,
+                  alpha_fc,beta,beta_ed,gamma,
+                  theta_alpha,geom,norm_pre_rhs);
+  }
 
   // for deterministic overdamped, we are done with the time step
   if (algorithm_type == 1 && variance_coef_mom == 0.) {
@@ -218,10 +226,15 @@ void advance(std::array< MultiFab, AMREX_SPACEDIM >& umac,
     MultiFab::Copy(umacNew[d], umac[d], 0, 0, 1, 0);
   }
 
-  // call GMRES here
-  gmres.Solve(gmres_rhs_u,gmres_rhs_p,umacNew,pres,
-              alpha_fc,beta,beta_ed,gamma,
-              theta_alpha,geom,norm_pre_rhs);
+  // compute corrector
+  if (use_fft) {
+      StokesFFTSolve(gmres_rhs_u,gmres_rhs_p,umacNew,pres,alpha_fc,beta,theta_alpha,geom);
+  }
+  else {
+      gmres.Solve(gmres_rhs_u,gmres_rhs_p,umacNew,pres,
+                  alpha_fc,beta,beta_ed,gamma,
+                  theta_alpha,geom,norm_pre_rhs);
+  }
 
   gmres_abs_tol = gmres_abs_tol_in; // Restore the desired tolerance
 
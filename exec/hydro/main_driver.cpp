@@ -10,6 +10,7 @@
 #include "common_functions.H"
 
 #include "gmres_functions.H"
+#include "rng_functions.H"
 
 
 #include <AMReX_VisMF.H>
@@ -474,6 +475,9 @@ void main_driver(const char* argv)
 
                 Real step_strt_time = ParallelDescriptor::second();
 
+                // key the counter-based noise by step so restarts reproduce it
+                CounterRNGSetStep(step);
+
                 if(variance_coef_mom != 0.0) {
 
                         // Fill stochastic terms
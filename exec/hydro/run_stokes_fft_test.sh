@@ -0,0 +1,69 @@
+#!/bin/bash
+
+# regression test for the periodic FFT Stokes solver (stokes_fft = 1):
+# for visc_type 1 and 2 and for alpha > 0 (algorithm_type = 0) and alpha = 0
+# (algorithm_type = 1), runs inputs_stokes_fft_2d with stokes_fft = 0 (GMRES)
+# and stokes_fft = 1 and requires the velocities and the pressure of the final
+# plotfiles to agree to relative tolerance $STOKES_FFT_TOL (default 1e-8, the
+# GMRES runs use gmres_rel_tol = 1e-12), checked with $FCOMPARE
+# (amrex/Tools/Plotfile/fcompare)
+
+dim="2"
+nprocs=${NPROCS:-4}
+input_file="inputs_stokes_fft_${dim}d"
+exec=./main${dim}d.gnu.MPI.ex
+STOKES_FFT_TOL=${STOKES_FFT_TOL:-1e-8}
+FCOMPARE=${FCOMPARE:-fcompare}
+
+# check plotfile comparison tool
+if ! command -v $FCOMPARE > /dev/null
+then
+  echo "ERROR: plotfile comparison tool $FCOMPARE not found; set FCOMPARE"
+  exit 1
+fi
+
+make -j${nprocs} DIM=${dim} || exit 1
+if [ ! -f $exec ]
+then
+  echo "ERROR: executable $exec not found"
+  exit 1
+fi
+exec=`realpath $exec`
+
+status=0
+for visc in 1 2
+do
+  for alg in 0 1
+  do
+    case=visc${visc}_alg${alg}
+    for fft in 0 1
+    do
+      dir=stokes_fft_test/${case}_fft${fft}
+      rm -rf $dir && mkdir -p $dir
+      cp $input_file $dir
+      (cd $dir && mpiexec -n ${nprocs} $exec $input_file visc_type=$visc algorithm_type=$alg stokes_fft=$fft > log)
+    done
+
+    pltfile=`cd stokes_fft_test/${case}_fft0 && ls -d plt* | tail -1`
+    if [ -z "$pltfile" ]
+    then
+      echo "$case: ERROR, no plotfile written"
+      status=1
+      continue
+    fi
+
+    for var in averaged_velx averaged_vely pres
+    do
+      if $FCOMPARE -r $STOKES_FFT_TOL -v $var stokes_fft_test/${case}_fft0/$pltfile stokes_fft_test/${case}_fft1/$pltfile \
+         > stokes_fft_test/${case}_fft1/fcompare.$var.log
+      then
+        echo "$case: $var agrees to relative tolerance $STOKES_FFT_TOL"
+      else
+        echo "$case: $var DIFFERS by more than relative tolerance $STOKES_FFT_TOL (see stokes_fft_test/${case}_fft1/fcompare.$var.log)"
+        status=1
+      fi
+    done
+  done
+done
+
+exit $status
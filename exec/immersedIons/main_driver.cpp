@@ -704,6 +704,22 @@ void main_driver(const char* argv)
         touched[d].setVal(0.0);
     }
 
+    // scratch data for applying the pinned mobility (pin_solver = 1), so the
+    // solution and initial guess in umac/pres are untouched
+    std::array< MultiFab, AMREX_SPACEDIM > umacPin;
+    std::array< MultiFab, AMREX_SPACEDIM > sourcePin;
+    std::array< MultiFab, AMREX_SPACEDIM > stochPin;
+    MultiFab presPin;
+    if (pin_solver == 1) {
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            umacPin  [d].define(convert(ba,nodal_flag_dir[d]), dmap, 1, ang);
+            sourcePin[d].define(convert(ba,nodal_flag_dir[d]), dmap, 1, ang);
+            stochPin [d].define(convert(ba,nodal_flag_dir[d]), dmap, 1, 0);
+            stochPin [d].setVal(0.0);
+        }
+        presPin.define(ba,dmap,1,1);
+    }
+
     //Define parametric paramplanes for particle interaction - declare array for paramplanes and then define properties in BuildParamplanes
 
 
@@ -1345,6 +1361,7 @@ void main_driver(const char* argv)
 
         // sr_tog is short range forces
         // es_tog is electrostatic solve (0=off, 1=Poisson, 2=Pairwise, 3=P3M)
+        // es_tog=3 scales as O(N log N): mesh solve plus neighbor-list short range correction
 
 
         if (sr_tog != 0 || es_tog==3) {
@@ -1444,7 +1461,22 @@ void main_driver(const char* argv)
                 particles.InterpolateMarkersGpu(0, dx, umac, RealFaceCoords, check);
                 particles.velNorm();
 
-                particles.pinnedParticleInversion();
+                if (pin_solver == 1) {
+                    particles.pinnedParticleSolve([&] () {
+                        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+                            umacPin   [d].setVal(0.0);
+                            sourcePin [d].setVal(0.0);
+                            sourceTemp[d].setVal(0.0);
+                        }
+                        presPin.setVal(0.0);
+                        particles.SpreadIonsGPU(dx, geom, umac, RealFaceCoords, sourcePin, sourceTemp);
+                        advanceStokes(umacPin,presPin,stochPin,sourcePin,alpha_fc,beta,gamma,beta_ed,geom,dt);
+                        particles.InterpolateMarkersGpu(0, dx, umacPin, RealFaceCoords, check);
+                    });
+                }
+                else {
+                    particles.pinnedParticleInversion();
+                }
 
                 for (int d=0; d<AMREX_SPACEDIM; ++d) {
                         source    [d].setVal(0.0);      // reset source terms
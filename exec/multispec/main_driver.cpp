@@ -535,6 +535,9 @@ void main_driver(const char* argv)
 
         Real step_strt_time = ParallelDescriptor::second();
 
+        // key the counter-based noise by step so restarts reproduce it
+        CounterRNGSetStep(istep);
+
         if (algorithm_type == 0) {
             // inertial
             AdvanceTimestepInertial(umac,rho_old,rho_new,rhotot_old,rhotot_new,
@@ -147,6 +147,10 @@ void main_driver(const char* argv)
 
     bCell.define(ba, dmap, paramPlaneCount, 1); bCell.setVal(-1);
 
+    // candidate planes of each cell, so that moves only test nearby planes
+    iMultiFab planeCell;
+    BuildPlaneCellIndex(paramPlaneList,paramPlaneCount,geom,ba,dmap,planeCell);
+
 
 
     // Particle tile size
@@ -191,7 +195,7 @@ void main_driver(const char* argv)
 
         particles.SourcePhonons(dt, paramPlaneList, paramPlaneCount);
 
-        particles.MovePhononsCPP(dt, paramPlaneList, paramPlaneCount, writeStep, istep, bCell);
+        particles.MovePhononsCPP(dt, paramPlaneList, paramPlaneCount, writeStep, istep, bCell, &planeCell);
 
         particles.EvaluateStatsPhonon(cuInst,cuMeans,cuVars,statsCount++,time);
 
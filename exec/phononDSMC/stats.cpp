@@ -48,8 +48,7 @@ void FhdParticleContainer::EvaluateStatsPhonon(MultiFab& mfcuInst,
 
         Real ocollisionCellVolTmp = ocollisionCellVol;
 
-        auto inds = m_bins.permutationPtr();
-        auto offs = m_bins.offsetsPtr();
+        const DsmcBinsView bins = getBins();
 
 
         //////////////////////////////////////
@@ -63,8 +62,8 @@ void FhdParticleContainer::EvaluateStatsPhonon(MultiFab& mfcuInst,
 
             for (int l=0; l<nspecies; l++) {
                // long np_spec = m_cell_vectors[l][grid_id][imap].size();
-                unsigned int np_spec = getBinSize(offs,iv,l,tile_box);
-                unsigned int* cellList = getCellList(inds,offs,iv,l,tile_box);
+                unsigned int np_spec = getBinSize(bins,iv,l,tile_box);
+                unsigned int* cellList = getCellList(bins,iv,l,tile_box);
 
                 cuInst(i,j,k,0) += np_spec;
 
@@ -7,6 +7,67 @@
 
 #include <AMReX_FFT.H>
 
+namespace {
+
+    // process-wide cache of R2C plans and spectral workspaces, keyed by the
+    // input layout and batch size, so every StructFact sampling the same
+    // domain reuses one plan instead of re-planning on each call
+    struct StructFactFFTPlan {
+        Box domain;
+        int batch;
+        BoxArray ba;
+        DistributionMapping dm;
+        std::unique_ptr<amrex::FFT::R2C<Real,FFT::Direction::forward>> fft;
+        MultiFab phi;       // contiguous input components on the caller's layout
+        cMultiFab phi_fft;  // distributed half spectrum
+        // single-grid buffers used by ComputeFFT, defined on first use
+        BoxArray ba_onegrid;
+        DistributionMapping dm_onegrid;
+        cMultiFab phi_fft_onegrid;
+        MultiFab dft_real_onegrid;
+        MultiFab dft_imag_onegrid;
+    };
+
+    Vector<std::unique_ptr<StructFactFFTPlan>> fft_plan_cache;
+
+    // plans hold FFT library and arena resources, so drop them before amrex::Finalize
+    void ClearFFTPlanCache ()
+    {
+        fft_plan_cache.clear();
+    }
+
+    StructFactFFTPlan& GetFFTPlan (const BoxArray& ba, const DistributionMapping& dm, int batch)
+    {
+        Box domain = ba.minimalBox();
+        for (auto& p : fft_plan_cache) {
+            if (p->batch == batch && p->domain == domain && p->ba == ba && p->dm == dm) {
+                return *p;
+            }
+        }
+
+        if (fft_plan_cache.empty()) {
+            amrex::ExecOnFinalize(ClearFFTPlanCache);
+        }
+
+        auto p = std::make_unique<StructFactFFTPlan>();
+        p->domain = domain;
+        p->batch = batch;
+        p->ba = ba;
+        p->dm = dm;
+
+        amrex::FFT::Info info{};
+        info.setBatchSize(batch);
+        p->fft = std::make_unique<amrex::FFT::R2C<Real,FFT::Direction::forward>>(domain, info);
+
+        auto const& [ba_fft, dm_fft] = p->fft->getSpectralDataLayout();
+        p->phi.define(ba, dm, batch, 0);
+        p->phi_fft.define(ba_fft, dm_fft, batch, 0);
+
+        fft_plan_cache.push_back(std::move(p));
+        return *fft_plan_cache.back();
+    }
+}
+
 // blank constructor
 StructFact::StructFact()
 {}
@@ -233,6 +294,11 @@ void StructFact::FortStructure(const MultiFab& variables,
 {
     BL_PROFILE_VAR("StructFact::FortStructure()", FortStructure);
 
+    if (struct_fact_batched == 1) {
+        FortStructureBatched(variables, reset);
+        return;
+    }
+
     const BoxArray& ba = variables.boxArray();
     const DistributionMapping& dm = variables.DistributionMap();
 
@@ -310,13 +376,201 @@ void StructFact::FortStructure(const MultiFab& variables,
     }
 }
 
+// batched version of FortStructure
+// all unique variables are transformed with a single multi-component R2C plan and the
+// covariances are accumulated directly on the distributed half-spectrum layout,
+// so no data is funneled through a single grid until UnpackSpectralCov() is called
+void StructFact::FortStructureBatched(const MultiFab& variables,
+                                      const int& reset)
+{
+    BL_PROFILE_VAR("StructFact::FortStructureBatched()", FortStructureBatched);
+
+    Box domain = variables.boxArray().minimalBox();
+
+    // each transformed variable is scaled by 1/sqrt(npts), so each product by 1/npts
+    long npts = domain.numPts();
+    Real npts_inv = 1.0 / (Real)npts;
+
+    // one cached amrex::FFT object transforms all NVARU variables at once
+    StructFactFFTPlan& plan = GetFFTPlan(variables.boxArray(), variables.DistributionMap(), NVARU);
+
+    const BoxArray& ba_fft = plan.phi_fft.boxArray();
+    const DistributionMapping& dm_fft = plan.phi_fft.DistributionMap();
+
+    // copy the unique variables into contiguous components
+    MultiFab& phi = plan.phi;
+    for (int n = 0; n < NVARU; n++) {
+        MultiFab::Copy(phi, variables, var_u[n], n, 1, 0);
+    }
+
+    cMultiFab& phi_fft = plan.phi_fft;
+
+    // ForwardTransform
+    plan.fft->forward(phi, phi_fft);
+
+    // (re)build the spectral accumulators if the layout changed
+    if (!cov_real_fft.ok() ||
+        cov_real_fft.boxArray() != ba_fft ||
+        cov_real_fft.DistributionMap() != dm_fft) {
+
+        UnpackSpectralCov();
+
+        cov_real_fft.define(ba_fft, dm_fft, NCOV, 0);
+        cov_imag_fft.define(ba_fft, dm_fft, NCOV, 0);
+        cov_real_fft.setVal(0.0);
+        cov_imag_fft.setVal(0.0);
+        nsamples_fft = 0;
+    }
+
+    if (reset == 1) {
+        cov_real.setVal(0.0);
+        cov_imag.setVal(0.0);
+        cov_real_fft.setVal(0.0);
+        cov_imag_fft.setVal(0.0);
+        nsamples_fft = 0;
+        nsamples = 0;
+    }
+
+    // position of each covariance pair within the transformed components
+    Gpu::HostVector<int> pairA_host(NCOV);
+    Gpu::HostVector<int> pairB_host(NCOV);
+    for (int n = 0; n < NCOV; n++) {
+        for (int m = 0; m < NVARU; m++) {
+            if (var_u[m] == s_pairA[n]) pairA_host[n] = m;
+            if (var_u[m] == s_pairB[n]) pairB_host[n] = m;
+        }
+    }
+
+    Gpu::DeviceVector<int> pairA_device(NCOV);
+    Gpu::DeviceVector<int> pairB_device(NCOV);
+    Gpu::copy(Gpu::hostToDevice, pairA_host.begin(), pairA_host.end(), pairA_device.begin());
+    Gpu::copy(Gpu::hostToDevice, pairB_host.begin(), pairB_host.end(), pairB_device.begin());
+
+    const int* pairA_ptr = pairA_device.dataPtr();
+    const int* pairB_ptr = pairB_device.dataPtr();
+
+    for (MFIter mfi(cov_real_fft, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+
+        Array4<const GpuComplex<Real>> const& spectral = phi_fft.const_array(mfi);
+        Array4<Real> const& cr = cov_real_fft.array(mfi);
+        Array4<Real> const& ci = cov_imag_fft.array(mfi);
+
+        amrex::ParallelFor(bx, NCOV, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            GpuComplex<Real> a = spectral(i, j, k, pairA_ptr[n]);
+            GpuComplex<Real> b = spectral(i, j, k, pairB_ptr[n]);
+
+            // conj(a)*b, same convention as the unbatched path
+            cr(i, j, k, n) += (a.real() * b.real() + a.imag() * b.imag()) * npts_inv;
+            ci(i, j, k, n) += (a.real() * b.imag() - a.imag() * b.real()) * npts_inv;
+        });
+    }
+
+    Gpu::streamSynchronize();
+
+    nsamples_fft++;
+    nsamples++;
+}
+
+// add the covariances accumulated on the half-spectrum layout into the full-spectrum
+// cov_real/cov_imag and zero the spectral accumulators
+// only needed before the covariances are used (plotfiles, checkpoints, Finalize)
+void StructFact::UnpackSpectralCov()
+{
+    if (nsamples_fft == 0 || !cov_real_fft.ok()) return;
+
+    BL_PROFILE_VAR("StructFact::UnpackSpectralCov()", UnpackSpectralCov);
+
+    Box domain = cov_real.boxArray().minimalBox();
+
+    // figure out which direction the spectral box is chopped (see ComputeFFT)
+    int chopped_dir = 0;
+    if (domain.length(0) > 1) {
+        chopped_dir = 0;
+    } else if (domain.length(1) > 1) {
+        chopped_dir = 1;
+#if (AMREX_SPACEDIM == 3)
+    } else if (domain.length(2) > 1) {
+        chopped_dir = 2;
+#endif
+    } else {
+        Abort("Calling UnpackSpectralCov for a MultiFab with only 1 cell");
+    }
+
+    BoxArray ba_onegrid(domain);
+    DistributionMapping dm_onegrid(ba_onegrid);
+
+    BoxArray ba_fft_onegrid(cov_real_fft.boxArray().minimalBox());
+
+    // real parts in components [0,NCOV), imaginary parts in [NCOV,2*NCOV)
+    MultiFab half_onegrid(ba_fft_onegrid, dm_onegrid, 2*NCOV, 0);
+    half_onegrid.ParallelCopy(cov_real_fft, 0, 0, NCOV);
+    half_onegrid.ParallelCopy(cov_imag_fft, 0, NCOV, NCOV);
+
+    MultiFab full_onegrid(ba_onegrid, dm_onegrid, 2*NCOV, 0);
+
+    int ncov = NCOV;
+
+    for (MFIter mfi(full_onegrid); mfi.isValid(); ++mfi) {
+        Box bx = mfi.fabbox();
+
+        Array4<const Real> const& half = half_onegrid.const_array(mfi);
+        Array4<Real> const& full = full_onegrid.array(mfi);
+
+        int nx = bx.length(0);
+        int ny = bx.length(1);
+#if (AMREX_SPACEDIM == 2)
+        int nz = 1;
+#elif (AMREX_SPACEDIM == 3)
+        int nz = bx.length(2);
+#endif
+
+        /*
+          For cells outside the computed half of the spectrum, the covariance conj(a)*b
+          at (Nx-i,Ny-j,Nz-k) (or 0 if that index is zero) is the complex conjugate of the value at (i,j,k)
+        */
+        amrex::ParallelFor(bx, ncov, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            bool mirror = (chopped_dir == 0) ? (i > nx / 2) :
+                          (chopped_dir == 1) ? (j > ny / 2) : (k > nz / 2);
+            if (!mirror) {
+                full(i, j, k, n)        = half(i, j, k, n);
+                full(i, j, k, n + ncov) = half(i, j, k, n + ncov);
+            } else {
+                int iloc = (i == 0) ? 0 : nx - i;
+                int jloc = (j == 0) ? 0 : ny - j;
+                int kloc = (k == 0) ? 0 : nz - k;
+                full(i, j, k, n)        =  half(iloc, jloc, kloc, n);
+                full(i, j, k, n + ncov) = -half(iloc, jloc, kloc, n + ncov);
+            }
+        });
+    }
+
+    // copy into a MF with same ba and dm as cov_real/imag/mag
+    MultiFab cov_temp(cov_real.boxArray(), cov_real.DistributionMap(), 2*NCOV, 0);
+    cov_temp.ParallelCopy(full_onegrid, 0, 0, 2*NCOV);
+
+    MultiFab::Add(cov_real, cov_temp, 0, 0, NCOV, 0);
+    MultiFab::Add(cov_imag, cov_temp, NCOV, 0, NCOV, 0);
+
+    cov_real_fft.setVal(0.0);
+    cov_imag_fft.setVal(0.0);
+    nsamples_fft = 0;
+}
+
 void StructFact::Reset() {
 
     BL_PROFILE_VAR("StructFact::Reset()", StructFactReset);
 
     cov_real.setVal(0.);
     cov_imag.setVal(0.);
+    if (cov_real_fft.ok()) {
+        cov_real_fft.setVal(0.);
+        cov_imag_fft.setVal(0.);
+    }
     nsamples = 0;
+    nsamples_fft = 0;
 }
 
 void StructFact::ComputeFFT(const MultiFab& variables,
@@ -349,31 +603,31 @@ void StructFact::ComputeFFT(const MultiFab& variables,
                                     : (domain.length(0) * domain.length(1) * domain.length(2));
     Real sqrtnpts = std::sqrt(npts);
 
-    // extract BoxArray and DistributionMapping from variables
-    BoxArray ba = variables.boxArray();
-    DistributionMapping dm = variables.DistributionMap();
+    // fetch the cached amrex::FFT object and workspaces for this layout
+    StructFactFFTPlan& plan = GetFFTPlan(variables.boxArray(), variables.DistributionMap(), 1);
 
-    // create storage for one component of variables
-    MultiFab phi(ba, dm, 1, 0);
+    // storage for one component of variables
+    MultiFab& phi = plan.phi;
 
-    // Initialize the boxarray "ba_onegrid" from the single box "domain"
-    // Initilize a DistributionMapping for one grid
-    BoxArray ba_onegrid(domain);
-    DistributionMapping dm_onegrid(ba_onegrid);
+    // storage for the FFT (distributed and single-grid)
+    cMultiFab& phi_fft = plan.phi_fft;
 
-    // create amrex::FFT object
-    amrex::FFT::R2C my_fft(domain);
+    if (plan.ba_onegrid.empty()) {
+        // Initialize the boxarray "ba_onegrid" from the single box "domain"
+        // Initilize a DistributionMapping for one grid
+        plan.ba_onegrid.define(domain);
+        plan.dm_onegrid.define(plan.ba_onegrid);
 
-    // create storage for the FFT (distributed and single-grid)
-    auto const& [ba_fft, dm_fft] = my_fft.getSpectralDataLayout();
-    FabArray<BaseFab<GpuComplex<amrex::Real>>> phi_fft(ba_fft, dm_fft, 1, 0);
+        BoxArray ba_fft_onegrid(phi_fft.boxArray().minimalBox());
+        plan.phi_fft_onegrid.define(ba_fft_onegrid, plan.dm_onegrid, 1, 0);
 
-    Box domain_fft = ba_fft.minimalBox();
-    BoxArray ba_fft_onegrid(domain_fft);
-    FabArray<BaseFab<GpuComplex<amrex::Real>>> phi_fft_onegrid(ba_fft_onegrid, dm_onegrid, 1, 0);
+        plan.dft_real_onegrid.define(plan.ba_onegrid, plan.dm_onegrid, 1, 0);
+        plan.dft_imag_onegrid.define(plan.ba_onegrid, plan.dm_onegrid, 1, 0);
+    }
 
-    MultiFab variables_dft_real_onegrid(ba_onegrid, dm_onegrid, 1, 0);
-    MultiFab variables_dft_imag_onegrid(ba_onegrid, dm_onegrid, 1, 0);
+    cMultiFab& phi_fft_onegrid = plan.phi_fft_onegrid;
+    MultiFab& variables_dft_real_onegrid = plan.dft_real_onegrid;
+    MultiFab& variables_dft_imag_onegrid = plan.dft_imag_onegrid;
 
     // we will take one FFT at a time and copy the answer into the
     // corresponding component of variables_dft_real/imag
@@ -392,9 +646,9 @@ void StructFact::ComputeFFT(const MultiFab& variables,
         MultiFab::Copy(phi, variables, comp, 0, 1, 0);
 
         // ForwardTransform
-        my_fft.forward(phi, phi_fft);
+        plan.fft->forward(phi, phi_fft);
 
-        // copy my_fft into a single-grid MultiFab
+        // copy the spectrum into a single-grid MultiFab
         phi_fft_onegrid.ParallelCopy(phi_fft, 0, 0, 1);
 
         // copy data to a full-sized MultiFab
@@ -524,6 +778,8 @@ void StructFact::WritePlotFile(const int step, const Real time,
 
     BL_PROFILE_VAR("StructFact::WritePlotFile()", StructFactWritePlotFile);
 
+    UnpackSpectralCov();
+
     MultiFab plotfile;
     Vector<std::string> varNames;
     int nPlot = 1;
@@ -627,6 +883,8 @@ void StructFact::CallFinalize(const int& zero_avg)
 {
     BL_PROFILE_VAR("CallFinalize()", CallFinalize);
 
+    UnpackSpectralCov();
+
     // Build temp real & imag components
     const BoxArray& ba = cov_mag.boxArray();
     const DistributionMapping& dm = cov_mag.DistributionMap();
@@ -980,6 +1238,8 @@ void StructFact::AddToExternal(MultiFab& x_mag, MultiFab& x_realimag, const int&
 
     BL_PROFILE_VAR("StructFact::AddToExternal", AddToExternal);
 
+    UnpackSpectralCov();
+
     MultiFab plotfile;
     int nPlot = 1;
 
@@ -1012,6 +1272,8 @@ void StructFact::WriteCheckPoint(const int& step,
                                  std::string checkfile_base)
 {
     // checkpoint file name, e.g., chk_SF0000010 (digits is how many digits...)
+    UnpackSpectralCov();
+
     const std::string& checkpointname = amrex::Concatenate(checkfile_base, step, 9);
 
     amrex::Print() << "Writing structure factor checkpoint " << checkpointname << "\n";
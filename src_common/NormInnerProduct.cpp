@@ -385,4 +385,150 @@ void CCL2Norm(const amrex::MultiFab& m1,
   norm_l2 = 0.;
   CCInnerProd(m1,comp,m1,comp,mscr,norm_l2);
   norm_l2 = sqrt(norm_l2);
-}
\ No newline at end of file
+}
+void StagL0Norm(const std::array<MultiFab, AMREX_SPACEDIM>& m1,
+  const int& comp,
+  amrex::Vector<amrex::Real>& norm_l0)
+{
+
+  BL_PROFILE_VAR("StagL0Norm()",StagL0Norm);
+
+  // local max norms, then one reduction for all directions
+  for (int d=0; d<AMREX_SPACEDIM; d++) {
+    norm_l0[d] = m1[d].norm0(comp,0,true);
+  }
+  ParallelDescriptor::ReduceRealMax(norm_l0.dataPtr(),AMREX_SPACEDIM);
+}
+
+namespace {
+
+  // add the weighted products of all pairs (mfa[p], mfb[p]) on one staggering into sum[index[p]]
+  // points on the grid boundary in each nodal direction are weighted by 1/2
+  // pairs are reduced four at a time in one pass over the data
+  void MultiDotPart(const Vector<const MultiFab*>& mfa,
+                    const Vector<int>& compa,
+                    const Vector<const MultiFab*>& mfb,
+                    const Vector<int>& compb,
+                    const Vector<int>& index,
+                    const Real& weight,
+                    Real* sum)
+  {
+    constexpr int chunk = 4;
+
+    int npairs = mfa.size();
+    if (npairs == 0) return;
+
+    const MultiFab& mf0 = *mfa[0];
+    IntVect nodal = mf0.ixType().toIntVect();
+
+    for (int p0=0; p0<npairs; p0+=chunk) {
+
+      const int nc = amrex::min(chunk, npairs-p0);
+
+      ReduceOps<ReduceOpSum,ReduceOpSum,ReduceOpSum,ReduceOpSum> reduce_op;
+      ReduceData<Real,Real,Real,Real> reduce_data(reduce_op);
+      using ReduceTuple = typename decltype(reduce_data)::Type;
+
+      for (MFIter mfi(mf0,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+      {
+        const Box& bx = mfi.tilebox();
+        const Box& bx_grid = mfi.validbox();
+
+        IntVect lo = bx_grid.smallEnd();
+        IntVect hi = bx_grid.bigEnd();
+
+        GpuArray<Array4<Real const>,chunk> fa;
+        GpuArray<Array4<Real const>,chunk> fb;
+        for (int q=0; q<chunk; ++q) {
+          const int p = p0 + amrex::min(q, nc-1);
+          fa[q] = mfa[p]->const_array(mfi,compa[p]);
+          fb[q] = mfb[p]->const_array(mfi,compb[p]);
+        }
+
+        reduce_op.eval(bx, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+        {
+          IntVect iv(AMREX_D_DECL(i,j,k));
+          Real w = weight;
+          for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            if (nodal[d] == 1 && (iv[d] == lo[d] || iv[d] == hi[d])) w *= 0.5;
+          }
+          Real prod[chunk];
+          for (int q=0; q<chunk; ++q) {
+            prod[q] = (q < nc) ? fa[q](i,j,k)*fb[q](i,j,k)*w : 0.;
+          }
+          return {prod[0],prod[1],prod[2],prod[3]};
+        });
+      }
+
+      ReduceTuple hv = reduce_data.value();
+      Real vals[chunk] = {amrex::get<0>(hv), amrex::get<1>(hv), amrex::get<2>(hv), amrex::get<3>(hv)};
+      for (int q=0; q<nc; ++q) {
+        sum[index[p0+q]] += vals[q];
+      }
+    }
+  }
+}
+
+void StagCCMultiDot(const amrex::Vector<StagCCField>& a,
+  const amrex::Vector<StagCCField>& b,
+  amrex::Vector<amrex::Real>& prod_val,
+  const amrex::Real& cc_weight,
+  const bool& local)
+{
+
+  BL_PROFILE_VAR("StagCCMultiDot()",StagCCMultiDot);
+
+  if (a.size() != b.size()) amrex::Abort("StagCCMultiDot:: a and b need to be the same size");
+
+  int nprod = a.size();
+
+  prod_val.resize(nprod);
+  std::fill(prod_val.begin(), prod_val.end(), 0.);
+  Real* sum_ptr = prod_val.dataPtr();
+
+  Vector<const MultiFab*> mfa;
+  Vector<const MultiFab*> mfb;
+  Vector<int> compa;
+  Vector<int> compb;
+  Vector<int> index;
+
+  auto clear = [&] () {
+    mfa.clear(); mfb.clear(); compa.clear(); compb.clear(); index.clear();
+  };
+
+  auto add = [&] (const MultiFab* ma, const MultiFab* mb, int n) {
+    mfa.push_back(ma); mfb.push_back(mb);
+    compa.push_back(a[n].comp); compb.push_back(b[n].comp);
+    index.push_back(n);
+  };
+
+  // faces
+  for (int d=0; d<AMREX_SPACEDIM; d++) {
+    clear();
+    for (int n=0; n<nprod; ++n) {
+      if (a[n].fc && b[n].fc) add(&(*a[n].fc)[d], &(*b[n].fc)[d], n);
+    }
+    MultiDotPart(mfa, compa, mfb, compb, index, 1., sum_ptr);
+  }
+
+  // cell-centers
+  clear();
+  for (int n=0; n<nprod; ++n) {
+    if (a[n].cc && b[n].cc) add(a[n].cc, b[n].cc, n);
+  }
+  MultiDotPart(mfa, compa, mfb, compb, index, cc_weight, sum_ptr);
+
+  // edges
+  for (int e=0; e<NUM_EDGE; e++) {
+    clear();
+    for (int n=0; n<nprod; ++n) {
+      if (a[n].ed && b[n].ed) add(&(*a[n].ed)[e], &(*b[n].ed)[e], n);
+    }
+    MultiDotPart(mfa, compa, mfb, compb, index, 1., sum_ptr);
+  }
+
+  if (!local) {
+    ParallelDescriptor::ReduceRealSum(prod_val.dataPtr(),nprod);
+  }
+}
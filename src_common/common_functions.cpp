@@ -29,6 +29,8 @@ AMREX_GPU_MANAGED amrex::GpuArray<int, MAX_SPECIES> common::pkernel_fluid; // GA
 AMREX_GPU_MANAGED amrex::GpuArray<int, MAX_SPECIES> common::pkernel_es;
 AMREX_GPU_MANAGED amrex::GpuArray<int, MAX_SPECIES> common::eskernel_fluid; // EXPONENTIAL OF SEMICIRCLE KERNEL; use this as w
 AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES> common::eskernel_beta; // EXPONENTIAL OF SEMICIRCLE KERNEL
+int                        common::spread_deterministic;
+int                        common::spread_weight_cache;
 amrex::Vector<amrex::Real> common::qval;
 
 amrex::Real                common::fixed_dt;
@@ -73,6 +75,7 @@ AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES> common::T_init;
 AMREX_GPU_MANAGED int      common::algorithm_type;
 int                        common::barodiffusion_type;
 int                        common::seed;
+int                        common::rng_counter_based;
 AMREX_GPU_MANAGED amrex::Real common::visc_coef;
 AMREX_GPU_MANAGED int      common::visc_type;
 AMREX_GPU_MANAGED int      common::advection_type;
@@ -149,6 +152,9 @@ AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> common::potential
 int                           common::n_burn;
 
 int                           common::dsmc_boundaries;
+int                           common::dsmc_collide_type;
+int                           common::dsmc_sorted_layout;
+amrex::Real                   common::dsmc_rebin_fraction;
 amrex::Real                   common::phonon_sound_speed;
 amrex::Real                   common::tau_ta;
 amrex::Real                   common::tau_la;
@@ -156,6 +162,7 @@ amrex::Real                   common::tau_i;
 int                           common::toggleTimeFrac;
 
 int                           common::struct_fact_int;
+int                           common::struct_fact_batched;
 int                           common::radialdist_int;
 int                           common::cartdist_int;
 int                           common::n_steps_skip;
@@ -207,6 +214,7 @@ int                        common::poisson_bottom_verbose;
 int                        common::poisson_max_iter;
 
 amrex::Real                common::poisson_rel_tol;
+int                        common::poisson_fft;
 AMREX_GPU_MANAGED amrex::Real common::permittivity;
 AMREX_GPU_MANAGED int      common::wall_mob;
 
@@ -226,6 +234,10 @@ AMREX_GPU_MANAGED int      common::sr_tog;
 int                        common::graphene_tog;
 int                        common::thermostat_tog;
 int                        common::zero_net_force;
+int                        common::pin_solver;
+amrex::Real                common::pin_solver_tol;
+int                        common::pin_solver_maxiter;
+int                        common::pin_solver_verbose;
 
 int                        common::crange;
 
@@ -351,6 +363,8 @@ void InitializeCommonNamespace() {
         eskernel_fluid[i] = -1;      // ES kernel for fluid
         eskernel_beta[i] = -1;       // ES kernel for fluid: beta
     }
+    spread_deterministic = 0;
+    spread_weight_cache = 0;
 
     // mass (no default)
     // nfrac (no default)
@@ -447,6 +461,9 @@ void InitializeCommonNamespace() {
     // positive = fixed seed
     seed = 0;
 
+    // 0 = stateful per-thread engine, 1 = counter-based (decomposition independent)
+    rng_counter_based = 0;
+
     // Viscous friction L phi operator
     // if abs(visc_type) = 1, L = div beta grad
     // if abs(visc_type) = 2, L = div [ beta (grad + grad^T) ]
@@ -532,6 +549,9 @@ void InitializeCommonNamespace() {
     }
 
     dsmc_boundaries = 0;
+    dsmc_collide_type = 0;
+    dsmc_sorted_layout = 0;
+    dsmc_rebin_fraction = 0.;
     n_burn = 1000;
     phonon_sound_speed = 600000.0;
     tau_i = 2.95e45;
@@ -541,6 +561,7 @@ void InitializeCommonNamespace() {
 
     // structure factor and radial/cartesian pair correlation function analysis
     struct_fact_int = 0;
+    struct_fact_batched = 0;
     radialdist_int = 0;
     cartdist_int = 0;
     n_steps_skip = 0;
@@ -579,6 +600,7 @@ void InitializeCommonNamespace() {
     poisson_bottom_verbose = 0;
     poisson_max_iter = 100;
     poisson_rel_tol = 1.e-10;
+    poisson_fft = 0;
 
     particle_grid_refine = 1;
     es_grid_refine = 1;
@@ -596,6 +618,10 @@ void InitializeCommonNamespace() {
     crange = 5;
     thermostat_tog = 0;
     zero_net_force = 0;
+    pin_solver = 0;
+    pin_solver_tol = 1.e-8;
+    pin_solver_maxiter = 200;
+    pin_solver_verbose = 0;
 
     // images (no default)
     for (int i=0; i<3; ++i) {
@@ -701,6 +727,8 @@ void InitializeCommonNamespace() {
             eskernel_beta[i] = temp[i];
         }
     }
+    pp.query("spread_deterministic",spread_deterministic);
+    pp.query("spread_weight_cache",spread_weight_cache);
     pp.queryarr("qval",qval,0,nspecies);
     pp.query("fixed_dt",fixed_dt);
     pp.query("cfl",cfl);
@@ -783,6 +811,7 @@ void InitializeCommonNamespace() {
     pp.query("algorithm_type",algorithm_type);
     pp.query("barodiffusion_type",barodiffusion_type);
     pp.query("seed",seed);
+    pp.query("rng_counter_based",rng_counter_based);
     pp.query("visc_coef",visc_coef);
     pp.query("visc_type",visc_type);
     pp.query("advection_type",advection_type);
@@ -993,6 +1022,9 @@ void InitializeCommonNamespace() {
         }
     }
     pp.query("dsmc_boundaries",dsmc_boundaries);
+    pp.query("dsmc_collide_type",dsmc_collide_type);
+    pp.query("dsmc_sorted_layout",dsmc_sorted_layout);
+    pp.query("dsmc_rebin_fraction",dsmc_rebin_fraction);
     pp.query("n_burn",n_burn);
     pp.query("phonon_sound_speed",phonon_sound_speed);
     pp.query("tau_i",tau_i);
@@ -1000,6 +1032,7 @@ void InitializeCommonNamespace() {
     pp.query("tau_la",tau_la);
     pp.query("toggleTimeFrac",toggleTimeFrac);
     pp.query("struct_fact_int",struct_fact_int);
+    pp.query("struct_fact_batched",struct_fact_batched);
     pp.query("radialdist_int",radialdist_int);
     pp.query("cartdist_int",cartdist_int);
     pp.query("n_steps_skip",n_steps_skip);
@@ -1114,6 +1147,7 @@ void InitializeCommonNamespace() {
     pp.query("poisson_bottom_verbose",poisson_bottom_verbose);
     pp.query("poisson_max_iter",poisson_max_iter);
     pp.query("poisson_rel_tol",poisson_rel_tol);
+    pp.query("poisson_fft",poisson_fft);
     pp.query("permittivity",permittivity);
     pp.query("wall_mob",wall_mob);
     pp.query("particle_grid_refine",particle_grid_refine);
@@ -1130,6 +1164,10 @@ void InitializeCommonNamespace() {
     pp.query("graphene_tog",graphene_tog);
     pp.query("thermostat_tog",thermostat_tog);
     pp.query("zero_net_force",zero_net_force);
+    pp.query("pin_solver",pin_solver);
+    pp.query("pin_solver_tol",pin_solver_tol);
+    pp.query("pin_solver_maxiter",pin_solver_maxiter);
+    pp.query("pin_solver_verbose",pin_solver_verbose);
     pp.query("crange",crange);
     pp.query("images",images);
     pp.queryarr("eamp",eamp,0,3);
@@ -11,6 +11,16 @@ AMREX_GPU_MANAGED int compressible::nspec_surfcov = 0;
 AMREX_GPU_MANAGED int compressible::turbRestartRun = 1;
 AMREX_GPU_MANAGED bool compressible::do_reservoir = false;
 AMREX_GPU_MANAGED amrex::Real compressible::zeta_ratio = -1.0;
+int compressible::stoch_low_mem = 0;
+AMREX_GPU_MANAGED int compressible::transport_cache = 0;
+AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES*MAX_SPECIES> compressible::tc_mu;
+AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES*MAX_SPECIES> compressible::tc_dbin;
+AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES*MAX_SPECIES> compressible::tc_omega11;
+AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES*MAX_SPECIES> compressible::tc_sigma11;
+AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES*MAX_SPECIES> compressible::tc_aij1;
+AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES*MAX_SPECIES> compressible::tc_aij2;
+AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES*MAX_SPECIES> compressible::tc_alphabar;
+AMREX_GPU_MANAGED amrex::GpuArray<amrex::Real, MAX_SPECIES> compressible::tc_eta1;
 
 void InitializeCompressibleNamespace()
 {
@@ -84,9 +94,98 @@ void InitializeCompressibleNamespace()
     if ((amrex::Math::abs(visc_type) == 3) and (zeta_ratio < 0.0)) amrex::Abort("need non-negative zeta_ratio (ratio of bulk to shear viscosity) for visc_type = 3 (use bulk viscosity)");
     if ((amrex::Math::abs(visc_type) == 3) and (zeta_ratio >= 0.0)) amrex::Print() << "bulk viscosity model selected; bulk viscosity ratio is: " << zeta_ratio << "\n";
 
+    // 1: regenerate the RK3 white noise fields on demand instead of storing them
+    pp.query("stoch_low_mem",stoch_low_mem);
+    if (stoch_low_mem == 1 && rng_counter_based != 1) amrex::Abort("stoch_low_mem = 1 requires rng_counter_based = 1");
+
+    // 1: tabulate the transport pair prefactors once instead of per cell
+    pp.query("transport_cache",transport_cache);
+    if (transport_cache == 1) InitTransportCache();
+
     return;
 }
 
+void InitTransportCache()
+{
+    // for hard spheres every pair quantity in the GIO and VW models is a
+    // constant times a power of T (and 1/p for Dbin), so the constants are
+    // tabulated here and the kernels only apply the T,p scalings
+    const Real pi = 3.1415926535897932;
+    const Real Fijstar = -27./5.;
+
+    GpuArray<Real,MAX_SPECIES> m;
+    for (int n=0; n<nspecies; ++n) {
+        m[n] = molmass[n]*(k_B/Runiv);
+    }
+
+    for (int i=0; i<nspecies; ++i) {
+        for (int j=0; j<nspecies; ++j) {
+            const int ij = i*MAX_SPECIES+j;
+            const Real diamat = 0.5*(diameter[i] + diameter[j]);
+            const Real mu = m[i]*m[j]/(m[i] + m[j]);
+            const Real Fij = (6.0*m[i]*m[i] + 13.0/5.0*m[j]*m[j] + 16.0/5.0*m[i]*m[j])/((m[i]+m[j])*(m[i]+m[j]));
+            const Real sigma11bar = std::sqrt( k_B/(2.0*pi*mu) )*pi*diamat*diamat;
+
+            tc_mu[ij]       = mu;
+            tc_dbin[ij]     = (3.0/16.0)*std::sqrt(2.0*pi*k_B*k_B*k_B/mu)/(pi*diamat*diamat);
+            tc_omega11[ij]  = std::sqrt(pi*k_B/(2.0*mu))*diamat*diamat;
+            tc_sigma11[ij]  = sigma11bar;
+            tc_aij1[ij]     = 5.0/k_B*mu*Fij*sigma11bar;
+            tc_aij2[ij]     = 5.0/k_B*mu*mu/(m[i]+m[j])*Fijstar*sigma11bar;
+            tc_alphabar[ij] = 8.0/(3.0*k_B)*mu*mu*(-.5*sigma11bar);
+        }
+        tc_eta1[i] = 5.0/(16.0*diameter[i]*diameter[i])*std::sqrt(m[i]*k_B/pi);
+    }
+
+    // check every tabulated quantity against the direct per-cell formulas
+    // (TransportPairVW/GIO, TransportEta1GIO) over a range of states; fall
+    // back to direct evaluation if any of them disagree
+    auto relerr = [] (Real cached, Real direct) {
+        const Real scale = amrex::max(std::abs(direct), std::abs(cached));
+        return (scale > 0.) ? std::abs(cached - direct)/scale : 0.;
+    };
+
+    const Real T_ref = (T_init[0] > 0.) ? T_init[0] : 300.;
+    const Real Tcheck[] = {0.1*T_ref, 0.5*T_ref, T_ref, 2.*T_ref, 10.*T_ref};
+    const Real pcheck[] = {1.01325e4, 1.01325e6, 1.01325e8};
+
+    Real maxerr = 0.;
+    for (Real T : Tcheck) {
+        const Real sqrtT = std::sqrt(T);
+        for (Real p : pcheck) {
+            const Real T32_p = T*sqrtT/p;
+            for (int i=0; i<nspecies; ++i) {
+                for (int j=0; j<nspecies; ++j) {
+                    const int ij = i*MAX_SPECIES+j;
+
+                    Real Dbin, omega11, sigma11, a_ij1, a_ij2, alphabar;
+                    TransportPairVW(i,j,T,p,m,Dbin,omega11,sigma11,a_ij1,a_ij2,alphabar);
+                    maxerr = amrex::max(maxerr, relerr(tc_dbin[ij]*T32_p, Dbin));
+                    maxerr = amrex::max(maxerr, relerr(tc_omega11[ij]*sqrtT, omega11));
+                    maxerr = amrex::max(maxerr, relerr(tc_sigma11[ij]*sqrtT, sigma11));
+                    maxerr = amrex::max(maxerr, relerr(tc_aij1[ij]/sqrtT, a_ij1));
+                    maxerr = amrex::max(maxerr, relerr(tc_aij2[ij]/sqrtT, a_ij2));
+                    maxerr = amrex::max(maxerr, relerr(tc_alphabar[ij], alphabar));
+
+                    Real mu;
+                    TransportPairGIO(i,j,T,p,m,mu,Dbin);
+                    maxerr = amrex::max(maxerr, relerr(tc_mu[ij], mu));
+                    maxerr = amrex::max(maxerr, relerr(tc_dbin[ij]*T32_p, Dbin));
+                }
+                maxerr = amrex::max(maxerr, relerr(tc_eta1[i]*sqrtT, TransportEta1GIO(i,T,m)));
+            }
+        }
+    }
+
+    if (maxerr > 1.e-10) {
+        amrex::Print() << "transport_cache: tabulated prefactors differ from direct evaluation by "
+                       << maxerr << "; using direct evaluation\n";
+        transport_cache = 0;
+    } else {
+        amrex::Print() << "transport_cache: pair prefactors tabulated" << "\n";
+    }
+}
+
 
 void GetHcGas() {
     for (int i=0; i<nspecies; ++i) {
@@ -1,15 +1,20 @@
 #include "compressible_functions.H"
 #include "common_functions.H"
 
+#include <utility>
+
 using namespace common;
 using namespace compressible;
 
-void calculateTransportCoeffs(const MultiFab& prim_in,
-                              MultiFab& eta_in, MultiFab& zeta_in, MultiFab& kappa_in,
-                              MultiFab& chi_in, MultiFab& Dij_in)
-{
-    BL_PROFILE_VAR("calculateTransportCoeffs()",calculateTransportCoeffs);
+namespace {
 
+// transport coefficient kernel with the number of species (NS) and the
+// transport model (TT) fixed at compile time; NS = 0 uses the runtime nspecies
+template <int NS, int TT>
+void TransportCoeffsKernel(const MultiFab& prim_in,
+                           MultiFab& eta_in, MultiFab& zeta_in, MultiFab& kappa_in,
+                           MultiFab& chi_in, MultiFab& Dij_in)
+{
     // see comments in conservedPrimitiveConversions.cpp regarding alternate ways of declaring
     // thread shared and thread private arrays on GPUs
     // if the size is not known at compile time, alternate approaches are required
@@ -36,6 +41,7 @@ void calculateTransportCoeffs(const MultiFab& prim_in,
 
         amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
         {
+            const int nspecies = (NS > 0) ? NS : common::nspecies;
 
             GpuArray<Real,MAX_SPECIES> Yk_fixed;
             GpuArray<Real,MAX_SPECIES> Xk_fixed;
@@ -55,18 +61,17 @@ void calculateTransportCoeffs(const MultiFab& prim_in,
             // compute mole fractions from mass fractions
             GetMolfrac(Yk_fixed, Xk_fixed);
 
-            if (transport_type == 1) { // Giovangigli
-                IdealMixtureTransportGIO(i,j,k, prim(i,j,k,0), prim(i,j,k,4), prim(i,j,k,5),
-                                         Yk_fixed, eta(i,j,k), kappa(i,j,k), zeta(i,j,k),
-                                         Dij, chi);
+            if constexpr (TT == 1) { // Giovangigli
+                IdealMixtureTransportGIO<NS>(i,j,k, prim(i,j,k,0), prim(i,j,k,4), prim(i,j,k,5),
+                                             Yk_fixed, eta(i,j,k), kappa(i,j,k), zeta(i,j,k),
+                                             Dij, chi);
             }
-
-            else if (transport_type == 2) { // Waldmann-Valk
-                IdealMixtureTransportVW(i,j,k, prim(i,j,k,0), prim(i,j,k,4), prim(i,j,k,5),
-                                      Yk_fixed, Xk_fixed, eta(i,j,k), kappa(i,j,k), zeta(i,j,k),
-                                      Dij, chi);
+            else if constexpr (TT == 2) { // Waldmann-Valk
+                IdealMixtureTransportVW<NS>(i,j,k, prim(i,j,k,0), prim(i,j,k,4), prim(i,j,k,5),
+                                            Yk_fixed, Xk_fixed, eta(i,j,k), kappa(i,j,k), zeta(i,j,k),
+                                            Dij, chi);
             }
-            else if (transport_type == 3) { // Hirschfelder-Curtiss-Bird for binary mixtures
+            else if constexpr (TT == 3) { // Hirschfelder-Curtiss-Bird for binary mixtures
                 IdealMixtureTransportHCBBin(i,j,k, prim(i,j,k,0), prim(i,j,k,4), prim(i,j,k,5),
                                             Yk_fixed, Xk_fixed, eta(i,j,k), kappa(i,j,k), zeta(i,j,k),
                                             Dij, chi);
@@ -88,4 +93,46 @@ void calculateTransportCoeffs(const MultiFab& prim_in,
 
         });
     }
-}
\ No newline at end of file
+}
+
+using TransportCoeffsFn = void (*)(const MultiFab&, MultiFab&, MultiFab&, MultiFab&, MultiFab&, MultiFab&);
+
+// pick TransportCoeffsKernel<ns,TT> from the instantiations for 1..MAX_SPECIES species
+template <int TT, int... N>
+TransportCoeffsFn SelectTransportKernel(const int ns, std::integer_sequence<int, N...>)
+{
+    TransportCoeffsFn fn = &TransportCoeffsKernel<0,TT>;
+    ((ns == N+1 ? (fn = &TransportCoeffsKernel<N+1,TT>, 0) : 0), ...);
+    return fn;
+}
+
+TransportCoeffsFn SelectTransportKernel()
+{
+    using Species = std::make_integer_sequence<int, MAX_SPECIES>;
+    switch (transport_type) {
+    case 1:
+        return SelectTransportKernel<1>(nspecies, Species{});
+    case 2:
+        return SelectTransportKernel<2>(nspecies, Species{});
+    case 3:
+        // binary mixtures only, nothing to specialize
+        return &TransportCoeffsKernel<0,3>;
+    default:
+        return &TransportCoeffsKernel<0,0>;
+    }
+}
+
+}
+
+void calculateTransportCoeffs(const MultiFab& prim_in,
+                              MultiFab& eta_in, MultiFab& zeta_in, MultiFab& kappa_in,
+                              MultiFab& chi_in, MultiFab& Dij_in)
+{
+    BL_PROFILE_VAR("calculateTransportCoeffs()",calculateTransportCoeffs);
+
+    // nspecies and transport_type are fixed once the namespaces are read,
+    // so the specialized kernel is selected on the first call only
+    static const TransportCoeffsFn kernel = SelectTransportKernel();
+
+    kernel(prim_in, eta_in, zeta_in, kappa_in, chi_in, Dij_in);
+}
@@ -76,37 +76,25 @@ void GetTurbQty(std::array< MultiFab, AMREX_SPACEDIM >& vel,
 
     // turbulent kinetic energy
 //   StagInnerProd(cumom,0,vel,0,macTemp,rhouu);
-    {
-        auto mask = cumom[0].OwnerMask(geom.periodicity());
-        rhouu[0] = MultiFab::Dot(cumom[0],0,vel[0],0,1,0);
+//    StagInnerProd(vel,0,vel,0,macTemp,uu);
+    // local dot products for rho*u.u and u.u, then one reduction for all six
+    Vector<Real> dots(6);
+    for (int d=0; d<3; ++d) {
+        dots[d]   = MultiFab::Dot(cumom[d],0,vel[d],0,1,0,true);
+        dots[d+3] = MultiFab::Dot(vel[d],0,vel[d],0,1,0,true);
     }
-    {
-        auto mask = cumom[1].OwnerMask(geom.periodicity());
-        rhouu[1] = MultiFab::Dot(cumom[1],0,vel[1],0,1,0);
-    }
-    {
-        auto mask = cumom[2].OwnerMask(geom.periodicity());
-        rhouu[2] = MultiFab::Dot(cumom[2],0,vel[2],0,1,0);
+    ParallelDescriptor::ReduceRealSum(dots.dataPtr(),6);
+    for (int d=0; d<3; ++d) {
+        rhouu[d] = dots[d];
+        uu[d]    = dots[d+3];
     }
+
     rhouu[0] /= (n_cells[0]+1)*n_cells[1]*n_cells[2];
     rhouu[1] /= (n_cells[1]+1)*n_cells[2]*n_cells[0];
     rhouu[2] /= (n_cells[2]+1)*n_cells[0]*n_cells[1];
     turbKE = 0.5*( rhouu[0] + rhouu[1] + rhouu[2] );
 
     // RMS velocity
-//    StagInnerProd(vel,0,vel,0,macTemp,uu);
-    {
-        auto mask = vel[0].OwnerMask(geom.periodicity());
-        uu[0] = MultiFab::Dot(vel[0],0,vel[0],0,1,0);
-    }
-    {
-        auto mask = vel[1].OwnerMask(geom.periodicity());
-        uu[1] = MultiFab::Dot(vel[1],0,vel[1],0,1,0);
-    }
-    {
-        auto mask = vel[2].OwnerMask(geom.periodicity());
-        uu[2] = MultiFab::Dot(vel[2],0,vel[2],0,1,0);
-    }
     uu[0] /= (n_cells[0]+1)*n_cells[1]*n_cells[2];
     uu[1] /= (n_cells[1]+1)*n_cells[2]*n_cells[0];
     uu[2] /= (n_cells[2]+1)*n_cells[0]*n_cells[1];
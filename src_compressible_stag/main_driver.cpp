@@ -1061,11 +1061,17 @@ void main_driver(const char* argv)
     //Time stepping loop
     /////////////////////////////////////////////////
 
+    // RK3 work arrays, reused across steps
+    RK3StagWorkspace rk3_ws;
+
     for (int step=step_start;step<=max_step;++step) {
 
         // timer
         Real ts1 = ParallelDescriptor::second();
 
+        // key the counter-based noise by step so restarts reproduce it
+        CounterRNGSetStep(step);
+
         // sample surface chemistry
 #if defined(MUI)
         mui_push(cu, prim, dx, uniface, step);
@@ -1103,7 +1109,7 @@ void main_driver(const char* argv)
         // FHD
         if (turbRestartRun) {
           RK3stepStag(cu, cumom, prim, vel, source, eta, zeta, kappa, chi, D,
-              faceflux, edgeflux_x, edgeflux_y, edgeflux_z, cenflux, ranchem, geom, dt, step, turbforce);
+              faceflux, edgeflux_x, edgeflux_y, edgeflux_z, cenflux, ranchem, geom, dt, step, turbforce, rk3_ws);
         } else {
             calculateTransportCoeffs(prim, eta, zeta, kappa, chi, D);
         }
@@ -1115,11 +1121,16 @@ void main_driver(const char* argv)
         // update surface chemistry (via either surfchem_mui or MFsurfchem)
 #if defined(MUI) || defined(USE_AMREX_MPMD)
 #if defined(MUI)
-        mui_fetch(cu, prim, dx, uniface, step);
+        // with mui_lag>0 the KMC counts of step-mui_lag are applied, so that
+        // the fetch does not wait for the KMC step running concurrently;
+        // MUI keeps the frames of the last mui_lag+1 steps until forgotten
+        if (step-mui_lag >= step_start) {
+            mui_fetch(cu, prim, dx, uniface, step-mui_lag);
 
-        mui_fetch_surfcov(Ntot, surfcov, dx, uniface, step);
+            mui_fetch_surfcov(Ntot, surfcov, dx, uniface, step-mui_lag);
 
-        mui_forget(uniface, step);
+            mui_forget(uniface, step-mui_lag);
+        }
 #elif defined(USE_AMREX_MPMD)
         amrex_fetch(cu, prim, geom.CellSizeArray(), *mpmd_copier);
         amrex_fetch_surfcov(Ntot, surfcov, *mpmd_copier);
@@ -1764,6 +1775,17 @@ void main_driver(const char* argv)
         }
     }
 
+#if defined(MUI)
+    // consume the KMC counts of the last mui_lag steps
+    for (int step=amrex::max(max_step-mui_lag+1,step_start); step<=max_step; ++step) {
+        mui_fetch(cu, prim, dx, uniface, step);
+
+        mui_fetch_surfcov(Ntot, surfcov, dx, uniface, step);
+
+        mui_forget(uniface, step);
+    }
+#endif
+
     if (ParallelDescriptor::IOProcessor()) outfile.close();
 #if defined(TURB)
     if (turbForcing >= 1) {
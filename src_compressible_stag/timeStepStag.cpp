@@ -10,163 +10,79 @@
 #include "rng_functions.H"
 #include <AMReX_VisMF.H>
 
-void RK3stepStag(MultiFab& cu,
-                 std::array< MultiFab, AMREX_SPACEDIM >& cumom,
-                 MultiFab& prim, std::array< MultiFab, AMREX_SPACEDIM >& vel,
-                 MultiFab& source,
-                 MultiFab& eta, MultiFab& zeta, MultiFab& kappa,
-                 MultiFab& chi, MultiFab& D,
-                 std::array<MultiFab, AMREX_SPACEDIM>& faceflux,
-                 std::array< MultiFab, 2 >& edgeflux_x,
-                 std::array< MultiFab, 2 >& edgeflux_y,
-                 std::array< MultiFab, 2 >& edgeflux_z,
-                 std::array< MultiFab, AMREX_SPACEDIM>& cenflux,
-                 MultiFab& ranchem,
-                 const amrex::Geometry& geom, const amrex::Real dt, const int step,
-                 TurbForcingComp& turbforce)
+bool RK3StagWorkspace::definedFor(const BoxArray& ba, const DistributionMapping& dm) const
 {
-    BL_PROFILE_VAR("RK3stepStag()",RK3stepStag);
-
-    MultiFab cup (cu.boxArray(),cu.DistributionMap(),nvars,ngc);
-    MultiFab cup2(cu.boxArray(),cu.DistributionMap(),nvars,ngc);
-    cup.setVal(0.0,0,nvars,ngc);
-    cup2.setVal(0.0,0,nvars,ngc);
-
-    ////////////////////////////////////////////////////////////////////////////////////////////////////////
-    // Reservoir stuff
-    std::array< MultiFab, AMREX_SPACEDIM > cumom_res; // MFab for storing momentum from reservoir update
-    std::array< MultiFab, AMREX_SPACEDIM > faceflux_res; // MFab for storing fluxes (face-based) from reservoir update
-    for (int d=0; d<AMREX_SPACEDIM; ++d) {
-        cumom_res[d].define(convert(cu.boxArray(),nodal_flag_dir[d]), cu.DistributionMap(), 1, 0);
-        faceflux_res[d].define(convert(cu.boxArray(),nodal_flag_dir[d]), cu.DistributionMap(), nvars, 0);
-    }
-    // Reservoir stuff
-    ////////////////////////////////////////////////////////////////////////////////////////////////////////
-
-    std::array< MultiFab, AMREX_SPACEDIM > cupmom;
-    std::array< MultiFab, AMREX_SPACEDIM > cup2mom;
-    AMREX_D_TERM(cupmom[0].define(convert(cu.boxArray(),nodal_flag_x), cu.DistributionMap(), 1, ngc);,
-                 cupmom[1].define(convert(cu.boxArray(),nodal_flag_y), cu.DistributionMap(), 1, ngc);,
-                 cupmom[2].define(convert(cu.boxArray(),nodal_flag_z), cu.DistributionMap(), 1, ngc););
-
-    AMREX_D_TERM(cup2mom[0].define(convert(cu.boxArray(),nodal_flag_x), cu.DistributionMap(), 1, ngc);,
-                 cup2mom[1].define(convert(cu.boxArray(),nodal_flag_y), cu.DistributionMap(), 1, ngc);,
-                 cup2mom[2].define(convert(cu.boxArray(),nodal_flag_z), cu.DistributionMap(), 1, ngc););
-
-    AMREX_D_TERM(cupmom[0].setVal(0.0);,
-                 cupmom[1].setVal(0.0);,
-                 cupmom[2].setVal(0.0););
-
-    AMREX_D_TERM(cup2mom[0].setVal(0.0);,
-                 cup2mom[1].setVal(0.0);,
-                 cup2mom[2].setVal(0.0););
-
-    const GpuArray<Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
-
-    /////////////////////////////////////////////////////
-    // Setup stochastic flux MultiFabs
-    std::array< MultiFab, AMREX_SPACEDIM > stochface;
-    AMREX_D_TERM(stochface[0].define(convert(cu.boxArray(),nodal_flag_x), cu.DistributionMap(), nvars, 0);,
-                 stochface[1].define(convert(cu.boxArray(),nodal_flag_y), cu.DistributionMap(), nvars, 0);,
-                 stochface[2].define(convert(cu.boxArray(),nodal_flag_z), cu.DistributionMap(), nvars, 0););
-
-    std::array< MultiFab, 2 > stochedge_x;
-    std::array< MultiFab, 2 > stochedge_y;
-    std::array< MultiFab, 2 > stochedge_z;
-
-    stochedge_x[0].define(convert(cu.boxArray(),nodal_flag_xy), cu.DistributionMap(), 1, 0);
-    stochedge_x[1].define(convert(cu.boxArray(),nodal_flag_xz), cu.DistributionMap(), 1, 0);
-
-    stochedge_y[0].define(convert(cu.boxArray(),nodal_flag_xy), cu.DistributionMap(), 1, 0);
-    stochedge_y[1].define(convert(cu.boxArray(),nodal_flag_yz), cu.DistributionMap(), 1, 0);
-
-    stochedge_z[0].define(convert(cu.boxArray(),nodal_flag_xz), cu.DistributionMap(), 1, 0);
-    stochedge_z[1].define(convert(cu.boxArray(),nodal_flag_yz), cu.DistributionMap(), 1, 0);
-
-    std::array< MultiFab, AMREX_SPACEDIM > stochcen;
-    AMREX_D_TERM(stochcen[0].define(cu.boxArray(),cu.DistributionMap(),1,1);,
-                 stochcen[1].define(cu.boxArray(),cu.DistributionMap(),1,1);,
-                 stochcen[2].define(cu.boxArray(),cu.DistributionMap(),1,1););
-    /////////////////////////////////////////////////////
-
-    /////////////////////////////////////////////////////
-    // Initialize white noise weighted fields
-    // weights for stochastic fluxes; swgt2 changes each stage
-    amrex::Vector< amrex::Real > stoch_weights;
-    amrex::Real swgt1, swgt2;
-    swgt1 = 1.0;
-
-    // field "A"
-    std::array< MultiFab, AMREX_SPACEDIM > stochface_A;
-    AMREX_D_TERM(stochface_A[0].define(stochface[0].boxArray(), stochface[0].DistributionMap(), nvars, 0);,
-                 stochface_A[1].define(stochface[1].boxArray(), stochface[1].DistributionMap(), nvars, 0);,
-                 stochface_A[2].define(stochface[2].boxArray(), stochface[2].DistributionMap(), nvars, 0););
-
-    std::array< MultiFab, 2 > stochedge_x_A;
-    std::array< MultiFab, 2 > stochedge_y_A;
-    std::array< MultiFab, 2 > stochedge_z_A;
-
-    stochedge_x_A[0].define(stochedge_x[0].boxArray(), stochedge_x[0].DistributionMap(), 1, 0);
-    stochedge_x_A[1].define(stochedge_x[1].boxArray(), stochedge_x[1].DistributionMap(), 1, 0);
-
-    stochedge_y_A[0].define(stochedge_y[0].boxArray(), stochedge_y[0].DistributionMap(), 1, 0);
-    stochedge_y_A[1].define(stochedge_y[1].boxArray(), stochedge_y[1].DistributionMap(), 1, 0);
-
-    stochedge_z_A[0].define(stochedge_z[0].boxArray(), stochedge_z[0].DistributionMap(), 1, 0);
-    stochedge_z_A[1].define(stochedge_z[1].boxArray(), stochedge_z[1].DistributionMap(), 1, 0);
-
-    std::array< MultiFab, AMREX_SPACEDIM > stochcen_A;
-    AMREX_D_TERM(stochcen_A[0].define(stochcen[0].boxArray(),stochcen[0].DistributionMap(),1,1);,
-                 stochcen_A[1].define(stochcen[1].boxArray(),stochcen[1].DistributionMap(),1,1);,
-                 stochcen_A[2].define(stochcen[2].boxArray(),stochcen[2].DistributionMap(),1,1););
+    return cup.ok() && cup.boxArray() == ba && cup.DistributionMap() == dm;
+}
 
-    // field "B"
-    std::array< MultiFab, AMREX_SPACEDIM > stochface_B;
-    AMREX_D_TERM(stochface_B[0].define(stochface[0].boxArray(), stochface[0].DistributionMap(), nvars, 0);,
-                 stochface_B[1].define(stochface[1].boxArray(), stochface[1].DistributionMap(), nvars, 0);,
-                 stochface_B[2].define(stochface[2].boxArray(), stochface[2].DistributionMap(), nvars, 0););
+void RK3StagWorkspace::define(const BoxArray& ba, const DistributionMapping& dm)
+{
+    BL_PROFILE_VAR("RK3StagWorkspace::define()",RK3StagWorkspaceDefine);
 
-    std::array< MultiFab, 2 > stochedge_x_B;
-    std::array< MultiFab, 2 > stochedge_y_B;
-    std::array< MultiFab, 2 > stochedge_z_B;
+    cup.define(ba, dm, nvars, ngc);
+    cup2.define(ba, dm, nvars, ngc);
 
-    stochedge_x_B[0].define(stochedge_x[0].boxArray(), stochedge_x[0].DistributionMap(), 1, 0);
-    stochedge_x_B[1].define(stochedge_x[1].boxArray(), stochedge_x[1].DistributionMap(), 1, 0);
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+        cumom_res[d].define(convert(ba,nodal_flag_dir[d]), dm, 1, 0);
+        faceflux_res[d].define(convert(ba,nodal_flag_dir[d]), dm, nvars, 0);
+        cupmom[d].define(convert(ba,nodal_flag_dir[d]), dm, 1, ngc);
+        cup2mom[d].define(convert(ba,nodal_flag_dir[d]), dm, 1, ngc);
+    }
+
+    // the stage noise plus, unless it is regenerated on demand, fields "A" and "B"
+    const int nsets = (stoch_low_mem == 1) ? 1 : 3;
+    std::array< std::array< MultiFab, AMREX_SPACEDIM >*, 3 > face = {&stochface, &stochface_A, &stochface_B};
+    std::array< std::array< MultiFab, 2 >*, 3 > edge_x = {&stochedge_x, &stochedge_x_A, &stochedge_x_B};
+    std::array< std::array< MultiFab, 2 >*, 3 > edge_y = {&stochedge_y, &stochedge_y_A, &stochedge_y_B};
+    std::array< std::array< MultiFab, 2 >*, 3 > edge_z = {&stochedge_z, &stochedge_z_A, &stochedge_z_B};
+    std::array< std::array< MultiFab, AMREX_SPACEDIM >*, 3 > cen = {&stochcen, &stochcen_A, &stochcen_B};
+
+    for (int s=0; s<nsets; ++s) {
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            (*face[s])[d].define(convert(ba,nodal_flag_dir[d]), dm, nvars, 0);
+            (*cen[s])[d].define(ba, dm, 1, 1);
+        }
 
-    stochedge_y_B[0].define(stochedge_y[0].boxArray(), stochedge_y[0].DistributionMap(), 1, 0);
-    stochedge_y_B[1].define(stochedge_y[1].boxArray(), stochedge_y[1].DistributionMap(), 1, 0);
+        (*edge_x[s])[0].define(convert(ba,nodal_flag_xy), dm, 1, 0);
+        (*edge_x[s])[1].define(convert(ba,nodal_flag_xz), dm, 1, 0);
 
-    stochedge_z_B[0].define(stochedge_z[0].boxArray(), stochedge_z[0].DistributionMap(), 1, 0);
-    stochedge_z_B[1].define(stochedge_z[1].boxArray(), stochedge_z[1].DistributionMap(), 1, 0);
+        (*edge_y[s])[0].define(convert(ba,nodal_flag_xy), dm, 1, 0);
+        (*edge_y[s])[1].define(convert(ba,nodal_flag_yz), dm, 1, 0);
 
-    std::array< MultiFab, AMREX_SPACEDIM > stochcen_B;
-    AMREX_D_TERM(stochcen_B[0].define(stochcen[0].boxArray(),stochcen[0].DistributionMap(),1,1);,
-                 stochcen_B[1].define(stochcen[1].boxArray(),stochcen[1].DistributionMap(),1,1);,
-                 stochcen_B[2].define(stochcen[2].boxArray(),stochcen[2].DistributionMap(),1,1););
+        (*edge_z[s])[0].define(convert(ba,nodal_flag_xz), dm, 1, 0);
+        (*edge_z[s])[1].define(convert(ba,nodal_flag_yz), dm, 1, 0);
+    }
 
     // chemistry
-    MultiFab ranchem_A;
-    MultiFab ranchem_B;
-    if (nreaction>0) {
-        ranchem_A.define(ranchem.boxArray(), ranchem.DistributionMap(), nreaction, 0);
-        ranchem_B.define(ranchem.boxArray(), ranchem.DistributionMap(), nreaction, 0);
+    if (nreaction>0 && stoch_low_mem == 0) {
+        ranchem_A.define(ba, dm, nreaction, 0);
+        ranchem_B.define(ba, dm, nreaction, 0);
     }
+}
 
-#if defined(TURB)
-    // turbulence -- calculate random velocity forcing
-    std::array< MultiFab, AMREX_SPACEDIM > turb_vel_f_o;
-    std::array< MultiFab, AMREX_SPACEDIM > turb_vel_f;
-    for (int d=0; d<AMREX_SPACEDIM; ++d) {
-        turb_vel_f_o[d].define(convert(cu.boxArray(),nodal_flag_dir[d]), cu.DistributionMap(), 1, 0);
-        turb_vel_f_o[d].setVal(0.);
-        turb_vel_f[d].define(convert(cu.boxArray(),nodal_flag_dir[d]), cu.DistributionMap(), 1, 0);
-        turb_vel_f[d].setVal(0.);
-    }
-    if (turbForcing > 1) {
-        turbforce.CalcTurbForcingComp(turb_vel_f_o,dt,0);
-        turbforce.CalcTurbForcingComp(turb_vel_f,dt,1);
-    }
-#endif
+// fill the white noise fields "A" and "B" once per step; with stoch_low_mem = 1
+// only reserve their counter-based draws so each stage can regenerate them
+static void FillStochNoise(RK3StagWorkspace& ws, const amrex::Geometry& geom)
+{
+    if (stoch_low_mem == 1) {
+        ws.draw_A = CounterRNGReserveDraws(2*RK3StagWorkspace::nslots);
+        ws.draw_B = ws.draw_A + RK3StagWorkspace::nslots;
+        return;
+    }
+
+    std::array< MultiFab, AMREX_SPACEDIM >& stochface_A = ws.stochface_A;
+    std::array< MultiFab, 2 >& stochedge_x_A = ws.stochedge_x_A;
+    std::array< MultiFab, 2 >& stochedge_y_A = ws.stochedge_y_A;
+    std::array< MultiFab, 2 >& stochedge_z_A = ws.stochedge_z_A;
+    std::array< MultiFab, AMREX_SPACEDIM >& stochcen_A = ws.stochcen_A;
+
+    std::array< MultiFab, AMREX_SPACEDIM >& stochface_B = ws.stochface_B;
+    std::array< MultiFab, 2 >& stochedge_x_B = ws.stochedge_x_B;
+    std::array< MultiFab, 2 >& stochedge_y_B = ws.stochedge_y_B;
+    std::array< MultiFab, 2 >& stochedge_z_B = ws.stochedge_z_B;
+    std::array< MultiFab, AMREX_SPACEDIM >& stochcen_B = ws.stochcen_B;
+    MultiFab& ranchem_A = ws.ranchem_A;
+    MultiFab& ranchem_B = ws.ranchem_B;
 
     // fill random numbers (can skip density component 0)
     if (do_1D) { // 1D need only for x- face
@@ -228,14 +144,63 @@ void RK3stepStag(MultiFab& cu,
             MultiFabFillRandom(ranchem_B, m, 1.0, geom);
         }
     }
+}
 
-    /////////////////////////////////////////////////////
+// set the stage noise to stoch_weights[0]*A + stoch_weights[1]*B
+static void WeightStochNoise(RK3StagWorkspace& ws, const amrex::Vector< amrex::Real >& stoch_weights,
+                             const amrex::Geometry& geom)
+{
+    std::array< MultiFab, AMREX_SPACEDIM >& stochface = ws.stochface;
+    std::array< MultiFab, 2 >& stochedge_x = ws.stochedge_x;
+    std::array< MultiFab, 2 >& stochedge_y = ws.stochedge_y;
+    std::array< MultiFab, 2 >& stochedge_z = ws.stochedge_z;
+    std::array< MultiFab, AMREX_SPACEDIM >& stochcen = ws.stochcen;
+
+    if (stoch_low_mem == 1) {
+        // slots: faces 0-2, x-edges 3-4, y-edges 5-6, z-edges 7-8, cell centers 9-11
+        const int nface = do_1D ? 1 : (do_2D ? 2 : AMREX_SPACEDIM);
+        for (int d=0; d<nface; ++d) {
+            MultiFabFillCounterRandomLinComb(stochface[d], 4, nvars-4,
+                                             stoch_weights[0], ws.draw_A+d,
+                                             stoch_weights[1], ws.draw_B+d, 1.0, geom);
+        }
 
-    /////////////////////////////////////////////////////
-    // Perform weighting of white noise fields
-    // Set stochastic weights
-    swgt2 = ( 2.0*std::sqrt(2.0) + 1.0*std::sqrt(3.0) ) / 5.0;
-    stoch_weights = {swgt1, swgt2};
+        const int nedge = do_1D ? 0 : (do_2D ? 1 : 2);
+        for (int i=0; i<nedge; ++i) {
+            MultiFabFillCounterRandomLinComb(stochedge_x[i], 0, 1,
+                                             stoch_weights[0], ws.draw_A+3+i,
+                                             stoch_weights[1], ws.draw_B+3+i, 1.0, geom);
+            MultiFabFillCounterRandomLinComb(stochedge_y[i], 0, 1,
+                                             stoch_weights[0], ws.draw_A+5+i,
+                                             stoch_weights[1], ws.draw_B+5+i, 1.0, geom);
+            if (!do_2D) {
+                MultiFabFillCounterRandomLinComb(stochedge_z[i], 0, 1,
+                                                 stoch_weights[0], ws.draw_A+7+i,
+                                                 stoch_weights[1], ws.draw_B+7+i, 1.0, geom);
+            }
+        }
+
+        const int ncen = do_1D ? 1 : (do_2D ? 2 : AMREX_SPACEDIM);
+        const Real var_cen = do_1D ? 1.0 : 2.0;
+        for (int i=0; i<ncen; ++i) {
+            MultiFabFillCounterRandomLinComb(stochcen[i], 0, 1,
+                                             stoch_weights[0], ws.draw_A+9+i,
+                                             stoch_weights[1], ws.draw_B+9+i, var_cen, geom);
+        }
+        return;
+    }
+
+    std::array< MultiFab, AMREX_SPACEDIM >& stochface_A = ws.stochface_A;
+    std::array< MultiFab, 2 >& stochedge_x_A = ws.stochedge_x_A;
+    std::array< MultiFab, 2 >& stochedge_y_A = ws.stochedge_y_A;
+    std::array< MultiFab, 2 >& stochedge_z_A = ws.stochedge_z_A;
+    std::array< MultiFab, AMREX_SPACEDIM >& stochcen_A = ws.stochcen_A;
+
+    std::array< MultiFab, AMREX_SPACEDIM >& stochface_B = ws.stochface_B;
+    std::array< MultiFab, 2 >& stochedge_x_B = ws.stochedge_x_B;
+    std::array< MultiFab, 2 >& stochedge_y_B = ws.stochedge_y_B;
+    std::array< MultiFab, 2 >& stochedge_z_B = ws.stochedge_z_B;
+    std::array< MultiFab, AMREX_SPACEDIM >& stochcen_B = ws.stochcen_B;
 
     // fill stochastic face fluxes
     if (do_1D) { // 1D need only for x- face
@@ -324,6 +289,112 @@ void RK3stepStag(MultiFab& cu,
                 0, 1, 1);
         }
     }
+}
+
+// set the chemistry noise to stoch_weights[0]*A + stoch_weights[1]*B
+static void WeightChemNoise(RK3StagWorkspace& ws, MultiFab& ranchem,
+                            const amrex::Vector< amrex::Real >& stoch_weights,
+                            const amrex::Geometry& geom)
+{
+    if (stoch_low_mem == 1) {
+        MultiFabFillCounterRandomLinComb(ranchem, 0, nreaction,
+                                         stoch_weights[0], ws.draw_A+12,
+                                         stoch_weights[1], ws.draw_B+12, 1.0, geom);
+    } else {
+        MultiFab::LinComb(ranchem,
+            stoch_weights[0], ws.ranchem_A, 0,
+            stoch_weights[1], ws.ranchem_B, 0,
+            0, nreaction, 0);
+    }
+}
+
+void RK3stepStag(MultiFab& cu,
+                 std::array< MultiFab, AMREX_SPACEDIM >& cumom,
+                 MultiFab& prim, std::array< MultiFab, AMREX_SPACEDIM >& vel,
+                 MultiFab& source,
+                 MultiFab& eta, MultiFab& zeta, MultiFab& kappa,
+                 MultiFab& chi, MultiFab& D,
+                 std::array<MultiFab, AMREX_SPACEDIM>& faceflux,
+                 std::array< MultiFab, 2 >& edgeflux_x,
+                 std::array< MultiFab, 2 >& edgeflux_y,
+                 std::array< MultiFab, 2 >& edgeflux_z,
+                 std::array< MultiFab, AMREX_SPACEDIM>& cenflux,
+                 MultiFab& ranchem,
+                 const amrex::Geometry& geom, const amrex::Real dt, const int step,
+                 TurbForcingComp& turbforce, RK3StagWorkspace& ws)
+{
+    BL_PROFILE_VAR("RK3stepStag()",RK3stepStag);
+
+    // (re)allocate the persistent work arrays only if the grids changed
+    if (!ws.definedFor(cu.boxArray(), cu.DistributionMap())) {
+        ws.define(cu.boxArray(), cu.DistributionMap());
+    }
+
+    MultiFab& cup  = ws.cup;
+    MultiFab& cup2 = ws.cup2;
+    cup.setVal(0.0,0,nvars,ngc);
+    cup2.setVal(0.0,0,nvars,ngc);
+
+    // Reservoir stuff
+    std::array< MultiFab, AMREX_SPACEDIM >& cumom_res = ws.cumom_res; // MFab for storing momentum from reservoir update
+    std::array< MultiFab, AMREX_SPACEDIM >& faceflux_res = ws.faceflux_res; // MFab for storing fluxes (face-based) from reservoir update
+
+    std::array< MultiFab, AMREX_SPACEDIM >& cupmom = ws.cupmom;
+    std::array< MultiFab, AMREX_SPACEDIM >& cup2mom = ws.cup2mom;
+
+    AMREX_D_TERM(cupmom[0].setVal(0.0);,
+                 cupmom[1].setVal(0.0);,
+                 cupmom[2].setVal(0.0););
+
+    AMREX_D_TERM(cup2mom[0].setVal(0.0);,
+                 cup2mom[1].setVal(0.0);,
+                 cup2mom[2].setVal(0.0););
+
+    const GpuArray<Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
+
+    /////////////////////////////////////////////////////
+    // Stochastic flux MultiFabs (weighted sums of fields "A" and "B")
+    std::array< MultiFab, AMREX_SPACEDIM >& stochface = ws.stochface;
+    std::array< MultiFab, 2 >& stochedge_x = ws.stochedge_x;
+    std::array< MultiFab, 2 >& stochedge_y = ws.stochedge_y;
+    std::array< MultiFab, 2 >& stochedge_z = ws.stochedge_z;
+    std::array< MultiFab, AMREX_SPACEDIM >& stochcen = ws.stochcen;
+    /////////////////////////////////////////////////////
+
+    // weights for stochastic fluxes; swgt2 changes each stage
+    amrex::Vector< amrex::Real > stoch_weights;
+    amrex::Real swgt1, swgt2;
+    swgt1 = 1.0;
+
+#if defined(TURB)
+    // turbulence -- calculate random velocity forcing
+    std::array< MultiFab, AMREX_SPACEDIM > turb_vel_f_o;
+    std::array< MultiFab, AMREX_SPACEDIM > turb_vel_f;
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+        turb_vel_f_o[d].define(convert(cu.boxArray(),nodal_flag_dir[d]), cu.DistributionMap(), 1, 0);
+        turb_vel_f_o[d].setVal(0.);
+        turb_vel_f[d].define(convert(cu.boxArray(),nodal_flag_dir[d]), cu.DistributionMap(), 1, 0);
+        turb_vel_f[d].setVal(0.);
+    }
+    if (turbForcing > 1) {
+        turbforce.CalcTurbForcingComp(turb_vel_f_o,dt,0);
+        turbforce.CalcTurbForcingComp(turb_vel_f,dt,1);
+    }
+#endif
+
+    // fill random numbers for fields "A" and "B"
+    FillStochNoise(ws, geom);
+
+    /////////////////////////////////////////////////////
+
+    /////////////////////////////////////////////////////
+    // Perform weighting of white noise fields
+    // Set stochastic weights
+    swgt2 = ( 2.0*std::sqrt(2.0) + 1.0*std::sqrt(3.0) ) / 5.0;
+    stoch_weights = {swgt1, swgt2};
+
+    // fill stochastic face, edge and cell-centered fluxes
+    WeightStochNoise(ws, stoch_weights, geom);
 
     /////////////////////////////////////////////////////
 
@@ -352,10 +423,7 @@ void RK3stepStag(MultiFab& cu,
     }
 
     if (nreaction>0) {
-        MultiFab::LinComb(ranchem,
-            stoch_weights[0], ranchem_A, 0,
-            stoch_weights[1], ranchem_B, 0,
-            0, nreaction, 0);
+        WeightChemNoise(ws, ranchem, stoch_weights, geom);
 
         compute_compressible_chemistry_source_CLE(dt, dx[0]*dx[1]*dx[2], prim, source, ranchem);
     }
@@ -568,93 +636,8 @@ void RK3stepStag(MultiFab& cu,
     swgt2 = ( -4.0*std::sqrt(2.0) + 3.0*std::sqrt(3.0) ) / 5.0;
     stoch_weights = {swgt1, swgt2};
 
-    // fill stochastic face fluxes
-    if (do_1D) { // 1D need only for x- face
-        MultiFab::LinComb(stochface[0],
-            stoch_weights[0], stochface_A[0], 4,
-            stoch_weights[1], stochface_B[0], 4,
-            4, nvars-4, 0);
-    }
-    else if (do_2D) { // 2D need only for x- and y- faces
-        MultiFab::LinComb(stochface[0],
-            stoch_weights[0], stochface_A[0], 4,
-            stoch_weights[1], stochface_B[0], 4,
-            4, nvars-4, 0);
-        MultiFab::LinComb(stochface[1],
-            stoch_weights[0], stochface_A[1], 4,
-            stoch_weights[1], stochface_B[1], 4,
-            4, nvars-4, 0);
-    }
-    else { // 3D
-        MultiFab::LinComb(stochface[0],
-            stoch_weights[0], stochface_A[0], 4,
-            stoch_weights[1], stochface_B[0], 4,
-            4, nvars-4, 0);
-        MultiFab::LinComb(stochface[1],
-            stoch_weights[0], stochface_A[1], 4,
-            stoch_weights[1], stochface_B[1], 4,
-            4, nvars-4, 0);
-        MultiFab::LinComb(stochface[2],
-            stoch_weights[0], stochface_A[2], 4,
-            stoch_weights[1], stochface_B[2], 4,
-            4, nvars-4, 0);
-    }
-
-    // fill stochastic edge fluxes
-    if (do_1D) { // 1D no transverse shear fluxes
-    }
-    else if (do_2D) { // 2D only xy-shear
-        MultiFab::LinComb(stochedge_x[0],
-            stoch_weights[0], stochedge_x_A[0], 0,
-            stoch_weights[1], stochedge_x_B[0], 0,
-            0, 1, 0);
-        MultiFab::LinComb(stochedge_y[0],
-            stoch_weights[0], stochedge_y_A[0], 0,
-            stoch_weights[1], stochedge_y_B[0], 0,
-            0, 1, 0);
-    }
-    else { // 3D
-        for (int i=0;i<2;i++) {
-            MultiFab::LinComb(stochedge_x[i],
-                stoch_weights[0], stochedge_x_A[i], 0,
-                stoch_weights[1], stochedge_x_B[i], 0,
-                0, 1, 0);
-            MultiFab::LinComb(stochedge_y[i],
-                stoch_weights[0], stochedge_y_A[i], 0,
-                stoch_weights[1], stochedge_y_B[i], 0,
-                0, 1, 0);
-            MultiFab::LinComb(stochedge_z[i],
-                stoch_weights[0], stochedge_z_A[i], 0,
-                stoch_weights[1], stochedge_z_B[i], 0,
-                0, 1, 0);
-        }
-    }
-
-    // fill stochastic cell-centered fluxes
-    if (do_1D) { // 1D no v_x and w_z stochastic terms
-        for (int i=0;i<1;i++) {
-            MultiFab::LinComb(stochcen[i],
-                stoch_weights[0], stochcen_A[i], 0,
-                stoch_weights[1], stochcen_B[i], 0,
-                0, 1, 1);
-        }
-    }
-    else if (do_2D) { // 2D simulation no w_z stochastic term
-        for (int i=0;i<2;i++) {
-            MultiFab::LinComb(stochcen[i],
-                stoch_weights[0], stochcen_A[i], 0,
-                stoch_weights[1], stochcen_B[i], 0,
-                0, 1, 1);
-        }
-    }
-    else { // 3D
-        for (int i=0;i<3;i++) {
-            MultiFab::LinComb(stochcen[i],
-                stoch_weights[0], stochcen_A[i], 0,
-                stoch_weights[1], stochcen_B[i], 0,
-                0, 1, 1);
-        }
-    }
+    // fill stochastic face, edge and cell-centered fluxes
+    WeightStochNoise(ws, stoch_weights, geom);
 
     ///////////////////////////////////////////////////////////
 
@@ -679,10 +662,7 @@ void RK3stepStag(MultiFab& cu,
     }
 
     if (nreaction>0) {
-        MultiFab::LinComb(ranchem,
-            stoch_weights[0], ranchem_A, 0,
-            stoch_weights[1], ranchem_B, 0,
-            0, nreaction, 0);
+        WeightChemNoise(ws, ranchem, stoch_weights, geom);
 
         compute_compressible_chemistry_source_CLE(dt, dx[0]*dx[1]*dx[2], prim, source, ranchem);
     }
@@ -901,93 +881,8 @@ void RK3stepStag(MultiFab& cu,
     swgt2 = ( 1.0*std::sqrt(2.0) - 2.0*std::sqrt(3.0) ) / 10.0;
     stoch_weights = {swgt1, swgt2};
 
-    // fill stochastic face fluxes
-    if (do_1D) { // 1D need only for x- face
-        MultiFab::LinComb(stochface[0],
-            stoch_weights[0], stochface_A[0], 4,
-            stoch_weights[1], stochface_B[0], 4,
-            4, nvars-4, 0);
-    }
-    else if (do_2D) { // 2D need only for x- and y- faces
-        MultiFab::LinComb(stochface[0],
-            stoch_weights[0], stochface_A[0], 4,
-            stoch_weights[1], stochface_B[0], 4,
-            4, nvars-4, 0);
-        MultiFab::LinComb(stochface[1],
-            stoch_weights[0], stochface_A[1], 4,
-            stoch_weights[1], stochface_B[1], 4,
-            4, nvars-4, 0);
-    }
-    else { // 3D
-        MultiFab::LinComb(stochface[0],
-            stoch_weights[0], stochface_A[0], 4,
-            stoch_weights[1], stochface_B[0], 4,
-            4, nvars-4, 0);
-        MultiFab::LinComb(stochface[1],
-            stoch_weights[0], stochface_A[1], 4,
-            stoch_weights[1], stochface_B[1], 4,
-            4, nvars-4, 0);
-        MultiFab::LinComb(stochface[2],
-            stoch_weights[0], stochface_A[2], 4,
-            stoch_weights[1], stochface_B[2], 4,
-            4, nvars-4, 0);
-    }
-
-    // fill stochastic edge fluxes
-    if (do_1D) { // 1D no transverse shear fluxes
-    }
-    else if (do_2D) { // 2D only xy-shear
-        MultiFab::LinComb(stochedge_x[0],
-            stoch_weights[0], stochedge_x_A[0], 0,
-            stoch_weights[1], stochedge_x_B[0], 0,
-            0, 1, 0);
-        MultiFab::LinComb(stochedge_y[0],
-            stoch_weights[0], stochedge_y_A[0], 0,
-            stoch_weights[1], stochedge_y_B[0], 0,
-            0, 1, 0);
-    }
-    else { // 3D
-        for (int i=0;i<2;i++) {
-            MultiFab::LinComb(stochedge_x[i],
-                stoch_weights[0], stochedge_x_A[i], 0,
-                stoch_weights[1], stochedge_x_B[i], 0,
-                0, 1, 0);
-            MultiFab::LinComb(stochedge_y[i],
-                stoch_weights[0], stochedge_y_A[i], 0,
-                stoch_weights[1], stochedge_y_B[i], 0,
-                0, 1, 0);
-            MultiFab::LinComb(stochedge_z[i],
-                stoch_weights[0], stochedge_z_A[i], 0,
-                stoch_weights[1], stochedge_z_B[i], 0,
-                0, 1, 0);
-        }
-    }
-
-    // fill stochastic cell-centered fluxes
-    if (do_1D) { // 1D no v_x and w_z stochastic terms
-        for (int i=0;i<1;i++) {
-            MultiFab::LinComb(stochcen[i],
-                stoch_weights[0], stochcen_A[i], 0,
-                stoch_weights[1], stochcen_B[i], 0,
-                0, 1, 1);
-        }
-    }
-    else if (do_2D) { // 2D simulation no w_z stochastic term
-        for (int i=0;i<2;i++) {
-            MultiFab::LinComb(stochcen[i],
-                stoch_weights[0], stochcen_A[i], 0,
-                stoch_weights[1], stochcen_B[i], 0,
-                0, 1, 1);
-        }
-    }
-    else { // 3D
-        for (int i=0;i<3;i++) {
-            MultiFab::LinComb(stochcen[i],
-                stoch_weights[0], stochcen_A[i], 0,
-                stoch_weights[1], stochcen_B[i], 0,
-                0, 1, 1);
-        }
-    }
+    // fill stochastic face, edge and cell-centered fluxes
+    WeightStochNoise(ws, stoch_weights, geom);
 
     ///////////////////////////////////////////////////////////
 
@@ -1012,10 +907,7 @@ void RK3stepStag(MultiFab& cu,
     }
 
     if (nreaction>0) {
-        MultiFab::LinComb(ranchem,
-            stoch_weights[0], ranchem_A, 0,
-            stoch_weights[1], ranchem_B, 0,
-            0, nreaction, 0);
+        WeightChemNoise(ws, ranchem, stoch_weights, geom);
 
         compute_compressible_chemistry_source_CLE(dt, dx[0]*dx[1]*dx[2], prim, source, ranchem);
     }
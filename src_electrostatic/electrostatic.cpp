@@ -2,20 +2,95 @@
 #include "common_functions.H"
 #include <AMReX_MLMG.H>
 
+#ifdef AMREX_USE_FFT
+#include <AMReX_FFT.H>
+#endif
+
 using namespace amrex;
 
-void esSolve(MultiFab& potential, MultiFab& charge,
-             std::array< MultiFab, AMREX_SPACEDIM >& efieldCC,
-             const std::array< MultiFab, AMREX_SPACEDIM >& external, const Geometry geom)
-{
-    BL_PROFILE_VAR("esSolve()",esSolve);
+namespace {
+
+    // Poisson solver kept across timesteps and rebuilt only when the grids change.
+    // Periodic and homogeneous Neumann domains use a discrete FFT solve (exact for
+    // the same 2nd order Laplacian); everything else reuses one MLPoisson/MLMG pair.
+    struct EsSolver {
+        Geometry geom;
+        BoxArray ba;
+        DistributionMapping dm;
+        bool use_fft = false;
+        std::unique_ptr<MLPoisson> linop;
+        std::unique_ptr<MLMG> mlmg;
+#ifdef AMREX_USE_FFT
+        std::unique_ptr<FFT::Poisson<MultiFab>> fft;
+#endif
+    };
+
+    std::unique_ptr<EsSolver> es_solver;
+
+    // MLMG and FFT objects hold arena memory, so drop them before amrex::Finalize
+    void ClearEsSolver ()
+    {
+        es_solver.reset();
+    }
 
-    AMREX_D_TERM(efieldCC[0].setVal(0);,
-                 efieldCC[1].setVal(0);,
-                 efieldCC[2].setVal(0););
+    bool EsFFTAvailable ()
+    {
+#ifdef AMREX_USE_FFT
+        if (poisson_fft == 0) {
+            return false;
+        }
+        for (int i=0; i<AMREX_SPACEDIM; ++i) {
+            const bool periodic = (bc_es_lo[i] == -1 && bc_es_hi[i] == -1);
+            const bool neumann  = (bc_es_lo[i] == 2 && bc_es_hi[i] == 2 &&
+                                   potential_lo[i] == 0. && potential_hi[i] == 0.);
+            if (!periodic && !neumann) {
+                return false;
+            }
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
 
-    if(es_tog==1 || es_tog==3)
+    EsSolver& GetEsSolver (const Geometry& geom, const BoxArray& ba, const DistributionMapping& dmap)
     {
+        const bool use_fft = EsFFTAvailable();
+
+        if (es_solver && es_solver->use_fft == use_fft && es_solver->ba == ba && es_solver->dm == dmap &&
+            es_solver->geom.Domain() == geom.Domain()) {
+            bool same_geom = true;
+            for (int i=0; i<AMREX_SPACEDIM; ++i) {
+                same_geom = same_geom && es_solver->geom.ProbLo(i) == geom.ProbLo(i)
+                                      && es_solver->geom.ProbHi(i) == geom.ProbHi(i);
+            }
+            if (same_geom) {
+                return *es_solver;
+            }
+        }
+
+        if (!es_solver) {
+            amrex::ExecOnFinalize(ClearEsSolver);
+        }
+
+        es_solver = std::make_unique<EsSolver>();
+        EsSolver& s = *es_solver;
+        s.geom = geom;
+        s.ba = ba;
+        s.dm = dmap;
+        s.use_fft = use_fft;
+
+        if (use_fft) {
+#ifdef AMREX_USE_FFT
+            Array<std::pair<FFT::Boundary,FFT::Boundary>,AMREX_SPACEDIM> fft_bc;
+            for (int i=0; i<AMREX_SPACEDIM; ++i) {
+                fft_bc[i] = (bc_es_lo[i] == -1) ? std::make_pair(FFT::Boundary::periodic,FFT::Boundary::periodic)
+                                                : std::make_pair(FFT::Boundary::even,FFT::Boundary::even);
+            }
+            s.fft = std::make_unique<FFT::Poisson<MultiFab>>(geom, fft_bc);
+#endif
+            return s;
+        }
 
         LinOpBCType lo_linop_bc[3];
         LinOpBCType hi_linop_bc[3];
@@ -45,42 +120,68 @@ void esSolve(MultiFab& potential, MultiFab& charge,
             }
         }
 
-        const BoxArray& ba = charge.boxArray();
-        const DistributionMapping& dmap = charge.DistributionMap();
-
         //create solver opject
-        MLPoisson linop({geom}, {ba}, {dmap});
+        s.linop = std::make_unique<MLPoisson>(Vector<Geometry>{geom}, Vector<BoxArray>{ba},
+                                              Vector<DistributionMapping>{dmap});
 
         //set BCs
-        linop.setDomainBC({AMREX_D_DECL(lo_linop_bc[0],
-                                        lo_linop_bc[1],
-                                        lo_linop_bc[2])},
-                          {AMREX_D_DECL(hi_linop_bc[0],
-                                        hi_linop_bc[1],
-                                        hi_linop_bc[2])});
-
-        // fill in ghost cells with Dirichlet/Neumann values
-        // the ghost cells will hold the value ON the boundary
-        MultiFabPotentialBC_solver(potential,geom);
-
-        // tell MLPoisson about these potentially inhomogeneous BC values
-        linop.setLevelBC(0, &potential);
+        s.linop->setDomainBC({AMREX_D_DECL(lo_linop_bc[0],
+                                           lo_linop_bc[1],
+                                           lo_linop_bc[2])},
+                             {AMREX_D_DECL(hi_linop_bc[0],
+                                           hi_linop_bc[1],
+                                           hi_linop_bc[2])});
 
         // this forces the solver to NOT enforce solvability
         // thus if there are Neumann conditions on phi they must
         // be correct or the Poisson solver won't converge
-        linop.setEnforceSingularSolvable(false);
+        s.linop->setEnforceSingularSolvable(false);
 
         //Multi Level Multi Grid
-        MLMG mlmg(linop);
+        s.mlmg = std::make_unique<MLMG>(*s.linop);
 
         //Solver parameters
-        mlmg.setMaxIter(poisson_max_iter);
-        mlmg.setVerbose(poisson_verbose);
-        mlmg.setBottomVerbose(poisson_bottom_verbose);
+        s.mlmg->setMaxIter(poisson_max_iter);
+        s.mlmg->setVerbose(poisson_verbose);
+        s.mlmg->setBottomVerbose(poisson_bottom_verbose);
+
+        return s;
+    }
+}
 
-        //Do solve
-        mlmg.solve({&potential}, {&charge}, poisson_rel_tol, 0.0);
+void esSolve(MultiFab& potential, MultiFab& charge,
+             std::array< MultiFab, AMREX_SPACEDIM >& efieldCC,
+             const std::array< MultiFab, AMREX_SPACEDIM >& external, const Geometry geom)
+{
+    BL_PROFILE_VAR("esSolve()",esSolve);
+
+    AMREX_D_TERM(efieldCC[0].setVal(0);,
+                 efieldCC[1].setVal(0);,
+                 efieldCC[2].setVal(0););
+
+    if(es_tog==1 || es_tog==3)
+    {
+        const BoxArray& ba = charge.boxArray();
+        const DistributionMapping& dmap = charge.DistributionMap();
+
+        EsSolver& solver = GetEsSolver(geom, ba, dmap);
+
+        if (solver.use_fft) {
+#ifdef AMREX_USE_FFT
+            solver.fft->solve(potential, charge);
+#endif
+        }
+        else {
+            // fill in ghost cells with Dirichlet/Neumann values
+            // the ghost cells will hold the value ON the boundary
+            MultiFabPotentialBC_solver(potential,geom);
+
+            // tell MLPoisson about these potentially inhomogeneous BC values
+            solver.linop->setLevelBC(0, &potential);
+
+            //Do solve, starting from the previous potential
+            solver.mlmg->solve({&potential}, {&charge}, poisson_rel_tol, 0.0);
+        }
 
         potential.FillBoundary(geom.periodicity());
         // set ghost cell values so electric field is calculated properly
@@ -2070,3 +2070,103 @@ void SetBoundaryCells(paramPlane* paramPlaneList, [[maybe_unused]] const int par
     }
 }
 
+
+// per-cell candidate list for find_inter_indexed_gpu:
+// planeCell(i,j,k,0) is the number of planes that may cross cell (i,j,k), or -1
+// if there are more than fit in the list; components 1..count hold the plane
+// numbers (from 1, as in find_inter_gpu). a plane is listed if its bounding box
+// and its infinite plane both touch the (slightly padded) cell, so no plane that
+// crosses the cell is missed
+void BuildPlaneCellIndex(paramPlane* paramPlaneList, const int paramPlaneCount, const Geometry & Geom, const BoxArray& ba,
+                         const DistributionMapping& dmap, iMultiFab& planeCell)
+{
+    BL_PROFILE_VAR("BuildPlaneCellIndex()",BuildPlaneCellIndex);
+
+    // lists longer than this are not stored; such cells test all planes
+    const int max_list = 32;
+    const int ngrow = 1;
+
+    const GpuArray<Real, 3> dx = Geom.CellSizeArray();
+    const GpuArray<Real, 3> plo = Geom.ProbLoArray();
+
+    Gpu::ManagedVector<paramPlane> paramPlaneListTmp;
+    paramPlaneListTmp.resize(paramPlaneCount);
+    for(int i=0;i<paramPlaneCount;i++)
+    {
+        paramPlaneListTmp[i]=paramPlaneList[i];
+    }
+    const paramPlane* paramPlaneListPtr = paramPlaneListTmp.data();
+    const int np = paramPlaneCount;
+
+    // does plane s cross the cell (i,j,k)?
+    auto crosses = [=] AMREX_GPU_DEVICE (int s, int i, int j, int k) noexcept -> bool
+    {
+        const paramPlane& surf = paramPlaneListPtr[s];
+        const int iv[3] = {i,j,k};
+        const Real o[3] = {surf.x0, surf.y0, surf.z0};
+        const Real u[3] = {surf.ux*surf.uTop, surf.uy*surf.uTop, surf.uz*surf.uTop};
+        const Real v[3] = {surf.vx*surf.vTop, surf.vy*surf.vTop, surf.vz*surf.vTop};
+        const Real n[3] = {u[1]*v[2]-u[2]*v[1], u[2]*v[0]-u[0]*v[2], u[0]*v[1]-u[1]*v[0]};
+
+        Real dist = 0.;
+        Real reach = 0.;
+        for (int d=0; d<3; ++d)
+        {
+            const Real pad = 1.e-6*dx[d];
+            const Real clo = plo[d] + iv[d]*dx[d] - pad;
+            const Real chi = plo[d] + (iv[d]+1)*dx[d] + pad;
+            const Real blo = o[d] + amrex::min(0.,u[d]) + amrex::min(0.,v[d]);
+            const Real bhi = o[d] + amrex::max(0.,u[d]) + amrex::max(0.,v[d]);
+            if (bhi < clo || blo > chi) return false;
+
+            dist += n[d]*(0.5*(clo+chi) - o[d]);
+            reach += 0.5*amrex::Math::abs(n[d])*(chi-clo);
+        }
+        return amrex::Math::abs(dist) <= reach;
+    };
+
+    iMultiFab count(ba, dmap, 1, ngrow);
+
+    for (MFIter mfi(count); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox();
+        const Array4<int> & cnt = count.array(mfi);
+
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            int c = 0;
+            for (int s=0; s<np; ++s)
+            {
+                if (crosses(s,i,j,k)) ++c;
+            }
+            cnt(i,j,k) = c;
+        });
+    }
+
+    const int ncomp = amrex::min(count.max(0,ngrow), max_list);
+
+    planeCell.define(ba, dmap, 1+ncomp, ngrow);
+
+    for (MFIter mfi(planeCell); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.growntilebox();
+        const Array4<int> & list = planeCell.array(mfi);
+        const Array4<int const> & cnt = count.const_array(mfi);
+
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            if (cnt(i,j,k) > ncomp)
+            {
+                list(i,j,k,0) = -1;
+                return;
+            }
+            int c = 0;
+            for (int s=0; s<np; ++s)
+            {
+                if (crosses(s,i,j,k)) list(i,j,k,++c) = s+1;
+            }
+            list(i,j,k,0) = c;
+        });
+    }
+    Gpu::streamSynchronize();
+}
@@ -68,6 +68,11 @@ void GMRES::Solve (std::array<MultiFab, AMREX_SPACEDIM> & b_u, MultiFab & b_p,
     Vector<Real> inner_prod_vel(AMREX_SPACEDIM);
     Real inner_prod_pres;
 
+    // inner products of w with V(0:i) followed by |w|^2 (gmres_type = 1)
+    Vector<StagCCField> block_a;
+    Vector<StagCCField> block_b;
+    Vector<Real> block_prod(gmres_max_inner+1);
+
     //////////////////////////////////////
     // account for inhomogeneous boundary conditions, e.g., moving walls
     // use r_u, tmp_u, r_p, tmp_p as temporary storage
@@ -145,6 +150,10 @@ void GMRES::Solve (std::array<MultiFab, AMREX_SPACEDIM> & b_u, MultiFab & b_p,
     }
 
 
+    // the coefficients are fixed for the rest of this solve, so coarsen them
+    // for the staggered multigrid preconditioner only once
+    StagSolver.SetCoefficients(alpha_fc, beta, beta_ed, gamma, theta_alpha);
+
     // First application of preconditioner
     Pcon.Apply(b_u, b_p, tmp_u, tmp_p, alpha_fc, alphainv_fc,
                beta, beta_ed, gamma, theta_alpha, geom, StagSolver);
@@ -179,6 +188,8 @@ void GMRES::Solve (std::array<MultiFab, AMREX_SPACEDIM> & b_u, MultiFab & b_p,
         }
         x_p.setVal(0.);
 
+        StagSolver.MarkCoefficientsDirty();
+
         if (gmres_verbose >= 1) {
             Print() << "GMRES.cpp: converged in 0 iterations since rhs=0" << std::endl;
         }
@@ -379,32 +390,75 @@ void GMRES::Solve (std::array<MultiFab, AMREX_SPACEDIM> & b_u, MultiFab & b_p,
 
             //___________________________________________________________________
             // Form Hessenberg matrix H
-            for (int k=0; k<=i; ++k) {
-                // H(k,i) = dot_product(w, V(k))
-                //        = dot_product(w_u, V_u(k))+dot_product(w_p, V_p(k))
-                StagInnerProd(w_u, 0, V_u, k, scr_u, inner_prod_vel);
-                CCInnerProd(w_p, 0, V_p, k, scr_p, inner_prod_pres);
-                H[k][i] = std::accumulate(inner_prod_vel.begin(), inner_prod_vel.end(), 0.)
-                          + pow(p_norm_weight, 2.0)*inner_prod_pres;
+            if (gmres_type == 1) {
+
+                // H(k,i) = dot_product(w, V(k)) for k=0..i and dot_product(w,w)
+                // in a single pass and a single reduction (classical Gram-Schmidt)
+                block_a.resize(i+2);
+                block_b.resize(i+2);
+                for (int k=0; k<=i; ++k) {
+                    block_a[k] = {&w_u, &w_p, nullptr, 0};
+                    block_b[k] = {&V_u, &V_p, nullptr, k};
+                }
+                block_a[i+1] = {&w_u, &w_p, nullptr, 0};
+                block_b[i+1] = {&w_u, &w_p, nullptr, 0};
+                StagCCMultiDot(block_a, block_b, block_prod, p_norm_weight*p_norm_weight);
+
+                Real norm_w_sq = block_prod[i+1];
+                Real norm_proj_sq = 0.;
+                for (int k=0; k<=i; ++k) {
+                    H[k][i] = block_prod[k];
+                    norm_proj_sq += H[k][i]*H[k][i];
+
+                    // w = w - H(k,i) * V(k)
+                    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+                        MultiFab::Saxpy(w_u[d], -H[k][i], V_u[d], k, 0, 1, 0);
+                    }
+                    MultiFab::Saxpy(w_p, -H[k][i], V_p, k, 0, 1, 0);
+                }
 
+                // H(i+1,i) = norm(w) = sqrt(|w|^2 - sum_k H(k,i)^2)
+                // fall back to an explicit norm if there is too much cancellation
+                Real norm_new_sq = norm_w_sq - norm_proj_sq;
+                if (norm_new_sq > 1.e-8*norm_w_sq) {
+                    H[i+1][i] = sqrt(norm_new_sq);
+                } else {
+                    StagL2Norm(w_u, 0, scr_u, norm_u);
+                    CCL2Norm(w_p, 0, scr_p, norm_p);
+                    norm_p    = p_norm_weight*norm_p;
+                    H[i+1][i] = sqrt(norm_u*norm_u + norm_p*norm_p);
+                }
 
-                // w = w - H(k,i) * V(k)
-                // use tmp_u and tmp_p as temporaries to hold kth component of V(k)
-                for (int d=0; d<AMREX_SPACEDIM; ++d) {
-                    MultiFab::Copy(tmp_u[d], V_u[d], k, 0, 1, 0);
-                    tmp_u[d].mult(H[k][i], 0, 1, 0);
-                    MultiFab::Subtract(w_u[d], tmp_u[d], 0, 0, 1, 0);
+            } else {
+
+                for (int k=0; k<=i; ++k) {
+                    // H(k,i) = dot_product(w, V(k))
+                    //        = dot_product(w_u, V_u(k))+dot_product(w_p, V_p(k))
+                    StagInnerProd(w_u, 0, V_u, k, scr_u, inner_prod_vel);
+                    CCInnerProd(w_p, 0, V_p, k, scr_p, inner_prod_pres);
+                    H[k][i] = std::accumulate(inner_prod_vel.begin(), inner_prod_vel.end(), 0.)
+                              + pow(p_norm_weight, 2.0)*inner_prod_pres;
+
+
+                    // w = w - H(k,i) * V(k)
+                    // use tmp_u and tmp_p as temporaries to hold kth component of V(k)
+                    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+                        MultiFab::Copy(tmp_u[d], V_u[d], k, 0, 1, 0);
+                        tmp_u[d].mult(H[k][i], 0, 1, 0);
+                        MultiFab::Subtract(w_u[d], tmp_u[d], 0, 0, 1, 0);
+                    }
+                    MultiFab::Copy(tmp_p, V_p, k, 0, 1, 0);
+                    tmp_p.mult(H[k][i], 0, 1, 0);
+                    MultiFab::Subtract(w_p,tmp_p, 0, 0, 1, 0);
                 }
-                MultiFab::Copy(tmp_p, V_p, k, 0, 1, 0);
-                tmp_p.mult(H[k][i], 0, 1, 0);
-                MultiFab::Subtract(w_p,tmp_p, 0, 0, 1, 0);
-            }
 
-            // H(i+1,i) = norm(w)
-            StagL2Norm(w_u, 0, scr_u, norm_u);
-            CCL2Norm(w_p, 0, scr_p, norm_p);
-            norm_p    = p_norm_weight*norm_p;
-            H[i+1][i] = sqrt(norm_u*norm_u + norm_p*norm_p);
+                // H(i+1,i) = norm(w)
+                StagL2Norm(w_u, 0, scr_u, norm_u);
+                CCL2Norm(w_p, 0, scr_p, norm_p);
+                norm_p    = p_norm_weight*norm_p;
+                H[i+1][i] = sqrt(norm_u*norm_u + norm_p*norm_p);
+
+            }
 
 
             //___________________________________________________________________
@@ -461,6 +515,9 @@ void GMRES::Solve (std::array<MultiFab, AMREX_SPACEDIM> & b_u, MultiFab & b_p,
 
     } while (true); // end of outer loop (do iter=1,gmres_max_outer)
 
+    // the coefficients may change before the next call
+    StagSolver.MarkCoefficientsDirty();
+
     // AJN - this is here since I notice epsilon roundoff errors building up
     //       just enough to destroy the asymmetry in time-advancement codes that
     //       ultimately causes lack of convergence in subsequent gmres calls
@@ -7,7 +7,8 @@ StagMGSolver::StagMGSolver() {}
 
 void StagMGSolver::Define(const BoxArray& ba_in,
                           const DistributionMapping& dmap_in,
-                          const Geometry& geom_in) {
+                          const Geometry& geom_in,
+                          const int& nlevs_max) {
 
     BL_PROFILE_VAR("StagMGSolver::Define()",StagMGSolver_Define);
 
@@ -20,6 +21,9 @@ void StagMGSolver::Define(const BoxArray& ba_in,
     // compute the number of multigrid levels assuming stag_mg_minwidth is the length of the
     // smallest dimension of the smallest grid at the coarsest multigrid level
     nlevs_mg = ComputeNlevsMG(ba_base);
+    if (nlevs_max > 0) {
+        nlevs_mg = std::min(nlevs_mg, nlevs_max);
+    }
     if (stag_mg_verbosity >= 3) {
         Print() << "Total number of multigrid levels: " << nlevs_mg << std::endl;
     }
@@ -95,41 +99,59 @@ void StagMGSolver::Define(const BoxArray& ba_in,
         }
     } // end loop over multigrid levels
 
-}
+    const int nbot = nlevs_mg-1;
+    const BoxArray& ba_bot = beta_cc_mg[nbot].boxArray();
 
+    bottom_solver.reset();
 
-// solve "(theta*alpha*I - L) phi = rhs" using multigrid with Gauss-Seidel relaxation
-// if amrex::Math::abs(visc_type) = 1, L = div beta grad
-// if amrex::Math::abs(visc_type) = 2, L = div [ beta (grad + grad^T) ]
-// if amrex::Math::abs(visc_type) = 3, L = div [ beta (grad + grad^T) + I (gamma - (2/3)*beta) div ]
-// if visc_type > 1 we assume constant coefficients
-// if visc_type < 1 we assume variable coefficients
-// beta_cc, and gamma_cc are cell-centered
-// alpha_fc, phi_fc, and rhs_fc are face-centered
-// beta_ed is nodal (2d) or edge-centered (3d)
-// phi_fc must come in initialized to some value, preferably a reasonable guess
-void StagMGSolver::Solve(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
-                         const MultiFab & beta_cc,
-                         const std::array<MultiFab, NUM_EDGE> & beta_ed,
-                         const MultiFab & gamma_cc,
-                         std::array<MultiFab, AMREX_SPACEDIM> & phi_fc,
-                         const std::array<MultiFab, AMREX_SPACEDIM> & rhs_fc,
-                         const Real & theta_alpha)
-{
-    BL_PROFILE_VAR("StagMGSolver::Solve()",StagMGSolver_Solve);
+    // agglomerate the coarsest level onto a single grid owned by one rank and
+    // keep coarsening there for up to stag_mg_max_bottom_nlevels additional levels;
+    // the nested solver has nlevs_max set and does plain smooths at its own bottom
+    if (stag_mg_bottom_solver == 4 && nlevs_max <= 0 && ba_bot.size() > 1) {
 
-    if (stag_mg_verbosity >= 1) {
-        Print() << "Begin call to stag_mg_solver\n";
+        BoxArray ba_agg(geom_mg[nbot].Domain());
+        DistributionMapping dmap_agg(ba_agg);
+
+        bottom_solver = std::make_unique<StagMGSolver>();
+        bottom_solver->Define(ba_agg, dmap_agg, geom_mg[nbot], stag_mg_max_bottom_nlevels+1);
+
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            phi_bottom[d].define(convert(ba_agg, nodal_flag_dir[d]), dmap_agg, 1, 1);
+            rhs_bottom[d].define(convert(ba_agg, nodal_flag_dir[d]), dmap_agg, 1, 0);
+        }
+
+        if (stag_mg_verbosity >= 3) {
+            Print() << "Agglomerated bottom solver with "
+                    << stag_mg_max_bottom_nlevels+1 << " levels at most" << std::endl;
+        }
     }
 
-    // initial and current residuals
-    Vector<Real> resid0(AMREX_SPACEDIM);
-    Vector<Real> resid0_l2(AMREX_SPACEDIM);
-    Vector<Real> resid(AMREX_SPACEDIM);
-    Vector<Real> resid_l2(AMREX_SPACEDIM);
-    Real resid_temp;
+    if (stag_mg_bottom_solver == 1) {
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            const BoxArray ba_face = convert(ba_bot, nodal_flag_dir[d]);
+            // p and s are operator inputs and need ghost cells
+            bicg_r[d].define   (ba_face, dmap, 1, 0);
+            bicg_rhat[d].define(ba_face, dmap, 1, 0);
+            bicg_p[d].define   (ba_face, dmap, 1, 1);
+            bicg_v[d].define   (ba_face, dmap, 1, 1);
+            bicg_s[d].define   (ba_face, dmap, 1, 1);
+            bicg_t[d].define   (ba_face, dmap, 1, 1);
+            bicg_p[d].setVal(0.);
+            bicg_s[d].setVal(0.);
+        }
+    }
+}
 
-    int n, color_start, color_end;
+
+// copy the coefficients into level 0 of the multigrid hierarchy and coarsen them
+// alpha_fc_mg is premultiplied by theta_alpha
+void StagMGSolver::CoarsenCoefficients(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
+                                       const MultiFab & beta_cc,
+                                       const std::array<MultiFab, NUM_EDGE> & beta_ed,
+                                       const MultiFab & gamma_cc,
+                                       const Real & theta_alpha)
+{
+    BL_PROFILE_VAR("StagMGSolver::CoarsenCoefficients()",StagMGSolver_CoarsenCoefficients);
 
     // copy level 1 coefficients into mg array of coefficients
     MultiFab::Copy(beta_cc_mg[0],  beta_cc,  0, 0, 1, 1);
@@ -147,8 +169,13 @@ void StagMGSolver::Solve(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
         MultiFab::Copy(beta_ed_mg[0][2], beta_ed[2], 0, 0, 1, 0);
     }
 
-    // coarsen coefficients
-    for (n=1; n<nlevs_mg; ++n) {
+    RestrictCoefficients();
+}
+
+// coarsen the level 0 coefficients to every coarser multigrid level
+void StagMGSolver::RestrictCoefficients()
+{
+    for (int n=1; n<nlevs_mg; ++n) {
         // need ghost cells set to zero to prevent intermediate NaN states
         // that cause some compilers to fail
         beta_cc_mg[n].setVal(0.);
@@ -179,6 +206,100 @@ void StagMGSolver::Solve(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
 #endif
     }
 
+    // the agglomerated bottom solver gets its own copy of the coarsest coefficients
+    if (bottom_solver) {
+        const int n = nlevs_mg-1;
+        bottom_solver->GatherCoefficients(alpha_fc_mg[n],beta_cc_mg[n],beta_ed_mg[n],gamma_cc_mg[n]);
+    }
+}
+
+// copy coefficients defined on another BoxArray of the same domain into level 0
+// alpha_fc is expected to be premultiplied by theta_alpha already
+void StagMGSolver::GatherCoefficients(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
+                                      const MultiFab & beta_cc,
+                                      const std::array<MultiFab, NUM_EDGE> & beta_ed,
+                                      const MultiFab & gamma_cc)
+{
+    BL_PROFILE_VAR("StagMGSolver::GatherCoefficients()",StagMGSolver_GatherCoefficients);
+
+    const Periodicity& period = geom_mg[0].periodicity();
+
+    // the cell-centered coefficients carry one ghost cell, including physical ghost cells
+    beta_cc_mg[0].setVal(0.);
+    gamma_cc_mg[0].setVal(0.);
+    beta_cc_mg[0].ParallelCopy (beta_cc,  0, 0, 1, 1, 1, period);
+    gamma_cc_mg[0].ParallelCopy(gamma_cc, 0, 0, 1, 1, 1, period);
+
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+        alpha_fc_mg[0][d].ParallelCopy(alpha_fc[d], 0, 0, 1, 0, 0, period);
+    }
+
+    for (int d=0; d<NUM_EDGE; ++d) {
+        beta_ed_mg[0][d].ParallelCopy(beta_ed[d], 0, 0, 1, 0, 0, period);
+    }
+
+    RestrictCoefficients();
+
+    coef_set = true;
+}
+
+// set the coefficients once; every following Solve reuses the coarsened hierarchy
+// until MarkCoefficientsDirty is called
+void StagMGSolver::SetCoefficients(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
+                                   const MultiFab & beta_cc,
+                                   const std::array<MultiFab, NUM_EDGE> & beta_ed,
+                                   const MultiFab & gamma_cc,
+                                   const Real & theta_alpha)
+{
+    CoarsenCoefficients(alpha_fc,beta_cc,beta_ed,gamma_cc,theta_alpha);
+    coef_set = true;
+}
+
+// solve "(theta*alpha*I - L) phi = rhs" using multigrid with Gauss-Seidel relaxation
+// if amrex::Math::abs(visc_type) = 1, L = div beta grad
+// if amrex::Math::abs(visc_type) = 2, L = div [ beta (grad + grad^T) ]
+// if amrex::Math::abs(visc_type) = 3, L = div [ beta (grad + grad^T) + I (gamma - (2/3)*beta) div ]
+// if visc_type > 1 we assume constant coefficients
+// if visc_type < 1 we assume variable coefficients
+// beta_cc, and gamma_cc are cell-centered
+// alpha_fc, phi_fc, and rhs_fc are face-centered
+// beta_ed is nodal (2d) or edge-centered (3d)
+// phi_fc must come in initialized to some value, preferably a reasonable guess
+void StagMGSolver::Solve(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
+                         const MultiFab & beta_cc,
+                         const std::array<MultiFab, NUM_EDGE> & beta_ed,
+                         const MultiFab & gamma_cc,
+                         std::array<MultiFab, AMREX_SPACEDIM> & phi_fc,
+                         const std::array<MultiFab, AMREX_SPACEDIM> & rhs_fc,
+                         const Real & theta_alpha)
+{
+    // without SetCoefficients, coarsen the coefficients on every call
+    if (!coef_set) {
+        CoarsenCoefficients(alpha_fc,beta_cc,beta_ed,gamma_cc,theta_alpha);
+    }
+
+    Solve(phi_fc,rhs_fc);
+}
+
+// solve using the coefficient hierarchy built by SetCoefficients (or the previous Solve)
+void StagMGSolver::Solve(std::array<MultiFab, AMREX_SPACEDIM> & phi_fc,
+                         const std::array<MultiFab, AMREX_SPACEDIM> & rhs_fc)
+{
+    BL_PROFILE_VAR("StagMGSolver::Solve()",StagMGSolver_Solve);
+
+    if (stag_mg_verbosity >= 1) {
+        Print() << "Begin call to stag_mg_solver\n";
+    }
+
+    // initial and current residuals
+    Vector<Real> resid0(AMREX_SPACEDIM);
+    Vector<Real> resid0_l2(AMREX_SPACEDIM);
+    Vector<Real> resid(AMREX_SPACEDIM);
+    Vector<Real> resid_l2(AMREX_SPACEDIM);
+    Real resid_temp;
+
+    int n, color_start, color_end;
+
     /*!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
     // Now we solve the homogeneous problem
     !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
@@ -210,9 +331,12 @@ void StagMGSolver::Solve(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
     for (int d=0; d<AMREX_SPACEDIM; ++d) {
         // compute Lphi - rhs
         MultiFab::Subtract(Lphi_fc_mg[0][d],rhs_fc_mg[0][d],0,0,1,1);
+    }
+
+    // compute L0 norm of Lphi - rhs (one reduction for all directions)
+    StagL0Norm(Lphi_fc_mg[0],0,resid0);
 
-        // compute L0 norm of Lphi - rhs
-        resid0[d] = Lphi_fc_mg[0][d].norm0();
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
 // FIXME - need to write an L2 norm for staggered fields
 //        resid0_l2[d] = Lphi_fc_mg[0][d].norm2();
         if (stag_mg_verbosity >= 2) {
@@ -373,59 +497,68 @@ void StagMGSolver::Solve(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
             Print() << "Begin bottom solve" << std::endl;
         }
 
-        ////////////////////////////
-        // just do smooths at the current level as the bottom solve
+        if (bottom_solver) {
+            // gather onto a single grid and run the nested multigrid
+            BottomSolveAgglomerated(n);
+        }
+        else if (stag_mg_bottom_solver == 1) {
+            BottomSolveBiCGStab(n);
+        }
+        else {
+            ////////////////////////////
+            // just do smooths at the current level as the bottom solve
 
-        // print out residual
-        if (stag_mg_verbosity >= 3) {
+            // print out residual
+            if (stag_mg_verbosity >= 3) {
 
-            // compute Lphi
-            StagApplyOp(geom_mg[n],beta_cc_mg[n],gamma_cc_mg[n],beta_ed_mg[n],
-                        phi_fc_mg[n],Lphi_fc_mg[n],alpha_fc_mg[n],dx_mg[n].data(),1.);
+                // compute Lphi
+                StagApplyOp(geom_mg[n],beta_cc_mg[n],gamma_cc_mg[n],beta_ed_mg[n],
+                            phi_fc_mg[n],Lphi_fc_mg[n],alpha_fc_mg[n],dx_mg[n].data(),1.);
 
-            // now subtract the rest of the RHS from Lphi.
-            for (int d=0; d<AMREX_SPACEDIM; ++d) {
-                // compute Lphi - rhs, and report residual
+                // now subtract the rest of the RHS from Lphi.
+                for (int d=0; d<AMREX_SPACEDIM; ++d) {
+                    // compute Lphi - rhs, and report residual
 
-                MultiFab::Subtract(Lphi_fc_mg[n][d],rhs_fc_mg[n][d],0,0,1,0);
-                resid_temp = Lphi_fc_mg[n][d].norm0();
-                Print() << "Residual for comp " << d << " before    smooths at level "
-                        << n << " " << resid_temp << std::endl;
+                    MultiFab::Subtract(Lphi_fc_mg[n][d],rhs_fc_mg[n][d],0,0,1,0);
+                    resid_temp = Lphi_fc_mg[n][d].norm0();
+                    Print() << "Residual for comp " << d << " before    smooths at level "
+                            << n << " " << resid_temp << std::endl;
+                }
             }
-        }
 
-        for (int m=1; m<=stag_mg_nsmooths_bottom; ++m) {
+            for (int m=1; m<=stag_mg_nsmooths_bottom; ++m) {
 
-            // do the smooths
-            for (int color=color_start; color<=color_end; ++color) {
+                // do the smooths
+                for (int color=color_start; color<=color_end; ++color) {
 
-                // the form of weighted Jacobi we are using is
-                // phi^{k+1} = phi^k + omega*D^{-1}*(rhs-Lphi)
-                // where D is the diagonal matrix containing the diagonal elements of L
+                    // the form of weighted Jacobi we are using is
+                    // phi^{k+1} = phi^k + omega*D^{-1}*(rhs-Lphi)
+                    // where D is the diagonal matrix containing the diagonal elements of L
 
-                // compute Lphi
-                StagApplyOp(geom_mg[n],beta_cc_mg[n],gamma_cc_mg[n],beta_ed_mg[n],
-                            phi_fc_mg[n],Lphi_fc_mg[n],alpha_fc_mg[n],dx_mg[n].data(),1.,color);
+                    // compute Lphi
+                    StagApplyOp(geom_mg[n],beta_cc_mg[n],gamma_cc_mg[n],beta_ed_mg[n],
+                                phi_fc_mg[n],Lphi_fc_mg[n],alpha_fc_mg[n],dx_mg[n].data(),1.,color);
 
-                // update phi = phi + omega*D^{-1}*(rhs-Lphi)
-                StagMGUpdate(phi_fc_mg[n],rhs_fc_mg[n],Lphi_fc_mg[n],alpha_fc_mg[n],
-                             beta_cc_mg[n],beta_ed_mg[n],gamma_cc_mg[n],dx_mg[n].data(),color);
+                    // update phi = phi + omega*D^{-1}*(rhs-Lphi)
+                    StagMGUpdate(phi_fc_mg[n],rhs_fc_mg[n],Lphi_fc_mg[n],alpha_fc_mg[n],
+                                 beta_cc_mg[n],beta_ed_mg[n],gamma_cc_mg[n],dx_mg[n].data(),color);
 
-                for (int d=0; d<AMREX_SPACEDIM; d++) {
+                    for (int d=0; d<AMREX_SPACEDIM; d++) {
 
-                    // set values on physical boundaires
-                    MultiFabPhysBCDomainVel(phi_fc_mg[n][d], geom_mg[n],d);
+                        // set values on physical boundaires
+                        MultiFabPhysBCDomainVel(phi_fc_mg[n][d], geom_mg[n],d);
 
-                    // fill periodic ghost cells
-                    phi_fc_mg[n][d].FillBoundary(geom_mg[n].periodicity());
+                        // fill periodic ghost cells
+                        phi_fc_mg[n][d].FillBoundary(geom_mg[n].periodicity());
 
-                    // fill physical ghost cells
-                    MultiFabPhysBCMacVel(phi_fc_mg[n][d], geom_mg[n],d);
-                }
+                        // fill physical ghost cells
+                        MultiFabPhysBCMacVel(phi_fc_mg[n][d], geom_mg[n],d);
+                    }
 
-            } // end loop over colors
+                } // end loop over colors
 
-        } // end loop over nsmooths
+            } // end loop over nsmooths
+        }
 
         ////////////////////
         // compute residual
@@ -579,8 +712,8 @@ void StagMGSolver::Solve(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
         }
 
         // compute L0 norm of Lphi - rhs and determine if the problem is solved
+        StagL0Norm(Lphi_fc_mg[0],0,resid);
         for (int d=0; d<AMREX_SPACEDIM; ++d) {
-            resid[d] = Lphi_fc_mg[0][d].norm0();
 // FIXME - need to write an L2 norm for staggered fields
 //            resid_l2[d] = Lphi_fc_mg[0][d].norm2();
             if (stag_mg_verbosity >= 2) {
@@ -656,6 +789,152 @@ void StagMGSolver::Solve(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
     }
 }
 
+// set values on physical boundaries and fill the periodic and physical ghost cells
+void StagMGSolver::FillFaceBoundary(std::array<MultiFab, AMREX_SPACEDIM> & phi, const int& n)
+{
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+        MultiFabPhysBCDomainVel(phi[d], geom_mg[n], d);
+        phi[d].FillBoundary(geom_mg[n].periodicity());
+        MultiFabPhysBCMacVel(phi[d], geom_mg[n], d);
+    }
+}
+
+// bottom solve on the agglomerated grid: copy the coarsest residual equation onto
+// the single-grid layout, run the nested multigrid there and copy the correction back
+void StagMGSolver::BottomSolveAgglomerated(const int& n)
+{
+    BL_PROFILE_VAR("StagMGSolver::BottomSolveAgglomerated()",StagMGSolver_BottomSolveAgglomerated);
+
+    const Periodicity& period = geom_mg[n].periodicity();
+
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+        rhs_bottom[d].ParallelCopy(rhs_fc_mg[n][d], 0, 0, 1, 0, 0, period);
+        phi_bottom[d].ParallelCopy(phi_fc_mg[n][d], 0, 0, 1, 0, 0, period);
+    }
+
+    bottom_solver->Solve(phi_bottom, rhs_bottom);
+
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+        phi_fc_mg[n][d].ParallelCopy(phi_bottom[d], 0, 0, 1, 0, 0, period);
+    }
+
+    FillFaceBoundary(phi_fc_mg[n], n);
+}
+
+// BiCGStab on the coarsest level, at most stag_mg_nsmooths_bottom iterations,
+// stopping once the residual is reduced by 1.e-4 (the MLMG bottom default)
+// the two inner products of each half step go through a single StagCCMultiDot
+void StagMGSolver::BottomSolveBiCGStab(const int& n)
+{
+    BL_PROFILE_VAR("StagMGSolver::BottomSolveBiCGStab()",StagMGSolver_BottomSolveBiCGStab);
+
+    const Real bottom_rel_tol = 1.e-4;
+
+    auto fc_field = [] (const std::array<MultiFab, AMREX_SPACEDIM> & m) {
+        StagCCField f;
+        f.fc = &m;
+        return f;
+    };
+
+    Vector<Real> dots(3);
+
+    // r = rhs - A phi; r is zero on physical boundary faces, where phi is prescribed
+    StagApplyOp(geom_mg[n],beta_cc_mg[n],gamma_cc_mg[n],beta_ed_mg[n],
+                phi_fc_mg[n],Lphi_fc_mg[n],alpha_fc_mg[n],dx_mg[n].data(),1.);
+
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+        MultiFab::LinComb(bicg_r[d], 1., rhs_fc_mg[n][d], 0, -1., Lphi_fc_mg[n][d], 0, 0, 1, 0);
+        MultiFabPhysBCDomainVel(bicg_r[d], geom_mg[n], d);
+        MultiFab::Copy(bicg_rhat[d], bicg_r[d], 0, 0, 1, 0);
+        bicg_p[d].setVal(0.);
+        bicg_v[d].setVal(0.);
+    }
+
+    Real rho = 1.;
+    Real alpha = 1.;
+    Real omega = 1.;
+    Real rnorm0 = -1.;
+
+    int iter;
+    for (iter=1; iter<=stag_mg_nsmooths_bottom; ++iter) {
+
+        // (rhat,r) and (r,r) together
+        StagCCMultiDot({fc_field(bicg_rhat), fc_field(bicg_r)},
+                       {fc_field(bicg_r),    fc_field(bicg_r)}, dots);
+
+        const Real rnorm = std::sqrt(dots[1]);
+        if (rnorm0 < 0.) {
+            rnorm0 = rnorm;
+        }
+        if (stag_mg_verbosity >= 4) {
+            Print() << "BiCGStab bottom iteration " << iter << " residual " << rnorm << std::endl;
+        }
+        if (rnorm <= bottom_rel_tol*rnorm0 || dots[0] == 0.) {
+            break;
+        }
+
+        const Real beta = (dots[0]/rho)*(alpha/omega);
+        rho = dots[0];
+
+        // p = r + beta*(p - omega*v)
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            MultiFab::Saxpy(bicg_p[d], -omega, bicg_v[d], 0, 0, 1, 0);
+            bicg_p[d].mult(beta, 0, 1, 0);
+            MultiFab::Add(bicg_p[d], bicg_r[d], 0, 0, 1, 0);
+        }
+        FillFaceBoundary(bicg_p, n);
+
+        // v = A p
+        StagApplyOp(geom_mg[n],beta_cc_mg[n],gamma_cc_mg[n],beta_ed_mg[n],
+                    bicg_p,bicg_v,alpha_fc_mg[n],dx_mg[n].data(),1.);
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            MultiFabPhysBCDomainVel(bicg_v[d], geom_mg[n], d);
+        }
+
+        StagCCMultiDot({fc_field(bicg_rhat)}, {fc_field(bicg_v)}, dots);
+        if (dots[0] == 0.) {
+            break;
+        }
+        alpha = rho/dots[0];
+
+        // s = r - alpha*v
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            MultiFab::LinComb(bicg_s[d], 1., bicg_r[d], 0, -alpha, bicg_v[d], 0, 0, 1, 0);
+        }
+        FillFaceBoundary(bicg_s, n);
+
+        // t = A s
+        StagApplyOp(geom_mg[n],beta_cc_mg[n],gamma_cc_mg[n],beta_ed_mg[n],
+                    bicg_s,bicg_t,alpha_fc_mg[n],dx_mg[n].data(),1.);
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            MultiFabPhysBCDomainVel(bicg_t[d], geom_mg[n], d);
+        }
+
+        // (t,s) and (t,t) together
+        StagCCMultiDot({fc_field(bicg_t), fc_field(bicg_t)},
+                       {fc_field(bicg_s), fc_field(bicg_t)}, dots);
+        omega = (dots[1] > 0.) ? dots[0]/dots[1] : 0.;
+
+        // phi = phi + alpha*p + omega*s, r = s - omega*t
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            MultiFab::Saxpy(phi_fc_mg[n][d], alpha, bicg_p[d], 0, 0, 1, 0);
+            MultiFab::Saxpy(phi_fc_mg[n][d], omega, bicg_s[d], 0, 0, 1, 0);
+            MultiFab::LinComb(bicg_r[d], 1., bicg_s[d], 0, -omega, bicg_t[d], 0, 0, 1, 0);
+        }
+
+        if (omega == 0.) {
+            break;
+        }
+    }
+
+    if (stag_mg_verbosity >= 3) {
+        Print() << "BiCGStab bottom solve done after " << iter-1
+                << " iterations" << std::endl;
+    }
+
+    FillFaceBoundary(phi_fc_mg[n], n);
+}
+
 // compute the number of multigrid levels assuming minwidth is the length of the
 // smallest dimension of the smallest grid at the coarsest multigrid level
 int StagMGSolver::ComputeNlevsMG(const BoxArray& ba) {
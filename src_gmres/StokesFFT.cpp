@@ -0,0 +1,261 @@
+#include "common_functions.H"
+#include "gmres_functions.H"
+
+#ifdef AMREX_USE_FFT
+#include <AMReX_FFT.H>
+#endif
+
+// Direct solver for the staggered Stokes system that GMRES::Solve iterates on,
+//   (theta_alpha*alpha - L_beta) x_u + G x_p = b_u
+//                                   -D x_u  = b_p
+// for fully periodic domains with constant coefficients. Each Fourier mode
+// decouples: with theta_d = 2 pi k_d / n_d, the MAC divergence of face data is
+// D_d = (e^{i theta_d} - 1)/dx_d, the gradient of cell data is G_d = -conj(D_d)
+// and the face Laplacian is -K2 with K2 = sum_d |D_d|^2. For constant beta
+//   L_beta = beta Lap            (abs(visc_type) = 1)
+//   L_beta = beta (Lap + G D)    (abs(visc_type) = 2)
+// so the Schur complement is a scalar per mode and the solve is one forward
+// and one backward transform of the (u, p) batch.
+
+namespace {
+
+#ifdef AMREX_USE_FFT
+    struct StokesFFTPlan {
+        Box domain;
+        BoxArray ba;
+        DistributionMapping dm;
+        std::unique_ptr<amrex::FFT::R2C<Real,FFT::Direction::both>> fft;
+        MultiFab phi;       // face components and pressure on the cell-centered layout
+        cMultiFab phi_fft;
+    };
+
+    Vector<std::unique_ptr<StokesFFTPlan>> stokes_fft_cache;
+
+    void ClearStokesFFTCache ()
+    {
+        stokes_fft_cache.clear();
+    }
+
+    StokesFFTPlan& GetStokesFFTPlan (const Box& domain, const BoxArray& ba, const DistributionMapping& dm)
+    {
+        for (auto& p : stokes_fft_cache) {
+            if (p->domain == domain && p->ba == ba && p->dm == dm) {
+                return *p;
+            }
+        }
+
+        if (stokes_fft_cache.empty()) {
+            amrex::ExecOnFinalize(ClearStokesFFTCache);
+        }
+
+        auto p = std::make_unique<StokesFFTPlan>();
+        p->domain = domain;
+        p->ba = ba;
+        p->dm = dm;
+
+        amrex::FFT::Info info{};
+        info.setBatchSize(AMREX_SPACEDIM+1);
+        p->fft = std::make_unique<amrex::FFT::R2C<Real,FFT::Direction::both>>(domain, info);
+
+        auto const& [ba_fft, dm_fft] = p->fft->getSpectralDataLayout();
+        p->phi.define(ba, dm, AMREX_SPACEDIM+1, 1);
+        p->phi_fft.define(ba_fft, dm_fft, AMREX_SPACEDIM+1, 0);
+
+        stokes_fft_cache.push_back(std::move(p));
+        return *stokes_fft_cache.back();
+    }
+#endif
+
+    bool IsConstant (const MultiFab& mf, Real& val)
+    {
+        Real mn = mf.min(0);
+        Real mx = mf.max(0);
+        val = mn;
+        return mn == mx;
+    }
+}
+
+bool StokesFFTAvailable(const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
+                        const MultiFab & beta,
+                        const std::array<MultiFab, NUM_EDGE> & beta_ed,
+                        const Real & theta_alpha,
+                        const Geometry & geom)
+{
+#ifdef AMREX_USE_FFT
+    if (stokes_fft == 0 || gmres_spatial_order != 2 || !geom.isAllPeriodic()) {
+        return false;
+    }
+    if (amrex::Math::abs(visc_type) != 1 && amrex::Math::abs(visc_type) != 2) {
+        return false;
+    }
+    if (geom.Domain().smallEnd() != IntVect::TheZeroVector()) {
+        return false;
+    }
+
+    Real beta0, val;
+    if (!IsConstant(beta, beta0)) {
+        return false;
+    }
+    if (visc_type < 0) {
+        for (int i=0; i<NUM_EDGE; ++i) {
+            if (!IsConstant(beta_ed[i], val) || val != beta0) {
+                return false;
+            }
+        }
+    }
+    if (theta_alpha != 0.) {
+        Real alpha0;
+        if (!IsConstant(alpha_fc[0], alpha0)) {
+            return false;
+        }
+        for (int d=1; d<AMREX_SPACEDIM; ++d) {
+            if (!IsConstant(alpha_fc[d], val) || val != alpha0) {
+                return false;
+            }
+        }
+    }
+    return true;
+#else
+    amrex::ignore_unused(alpha_fc,beta,beta_ed,theta_alpha,geom);
+    return false;
+#endif
+}
+
+void StokesFFTSolve(const std::array<MultiFab, AMREX_SPACEDIM> & b_u,
+                    const MultiFab & b_p,
+                    std::array<MultiFab, AMREX_SPACEDIM> & x_u,
+                    MultiFab & x_p,
+                    const std::array<MultiFab, AMREX_SPACEDIM> & alpha_fc,
+                    const MultiFab & beta,
+                    const Real & theta_alpha,
+                    const Geometry & geom)
+{
+    BL_PROFILE_VAR("StokesFFTSolve()", StokesFFTSolve);
+
+#ifdef AMREX_USE_FFT
+    const Box& domain = geom.Domain();
+    const BoxArray& ba = b_p.boxArray();
+    const DistributionMapping& dmap = b_p.DistributionMap();
+
+    StokesFFTPlan& plan = GetStokesFFTPlan(domain, ba, dmap);
+    MultiFab& phi = plan.phi;
+    cMultiFab& phi_fft = plan.phi_fft;
+
+    const Real npts = domain.d_numPts();
+    const GpuArray<Real,AMREX_SPACEDIM> dx = geom.CellSizeArray();
+    const IntVect n = domain.length();
+
+    // the zero mode is not determined when alpha = 0; keep the means of the
+    // initial guess there, as GMRES does
+    Real mean[AMREX_SPACEDIM+1];
+    for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+        const Array4<Real> & ph = phi.array(mfi);
+        AMREX_D_TERM(Array4<Real const> const& xu = x_u[0].const_array(mfi);,
+                     Array4<Real const> const& xv = x_u[1].const_array(mfi);,
+                     Array4<Real const> const& xw = x_u[2].const_array(mfi););
+        Array4<Real const> const& xp = x_p.const_array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            AMREX_D_TERM(ph(i,j,k,0) = xu(i,j,k);,
+                         ph(i,j,k,1) = xv(i,j,k);,
+                         ph(i,j,k,2) = xw(i,j,k););
+            ph(i,j,k,AMREX_SPACEDIM) = xp(i,j,k);
+        });
+    }
+    for (int c=0; c<=AMREX_SPACEDIM; ++c) {
+        mean[c] = phi.sum(c) / npts;
+    }
+
+    // face i of each velocity component is stored in cell i
+    for (MFIter mfi(phi, TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.tilebox();
+        const Array4<Real> & ph = phi.array(mfi);
+        AMREX_D_TERM(Array4<Real const> const& bu = b_u[0].const_array(mfi);,
+                     Array4<Real const> const& bv = b_u[1].const_array(mfi);,
+                     Array4<Real const> const& bw = b_u[2].const_array(mfi););
+        Array4<Real const> const& bp = b_p.const_array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            AMREX_D_TERM(ph(i,j,k,0) = bu(i,j,k);,
+                         ph(i,j,k,1) = bv(i,j,k);,
+                         ph(i,j,k,2) = bw(i,j,k););
+            ph(i,j,k,AMREX_SPACEDIM) = bp(i,j,k);
+        });
+    }
+
+    plan.fft->forward(phi, phi_fft);
+
+    const Real beta0 = beta.min(0);
+    const Real a0 = (theta_alpha != 0.) ? theta_alpha*alpha_fc[0].min(0) : 0.;
+    const Real cgd = (amrex::Math::abs(visc_type) == 2) ? beta0 : 0.; // coefficient of G D in L_beta
+    const Real scale = 1./npts;
+    GpuArray<Real,AMREX_SPACEDIM+1> mean_gpu;
+    for (int c=0; c<=AMREX_SPACEDIM; ++c) {
+        mean_gpu[c] = mean[c];
+    }
+
+    for (MFIter mfi(phi_fft); mfi.isValid(); ++mfi) {
+        const Box& bx = mfi.validbox();
+        Array4<GpuComplex<Real>> const& spec = phi_fft.array(mfi);
+        amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+        {
+            const IntVect kv(AMREX_D_DECL(i,j,k));
+            GpuComplex<Real> D[AMREX_SPACEDIM];
+            Real K2 = 0.;
+            for (int d=0; d<AMREX_SPACEDIM; ++d) {
+                const Real th = 2.*M_PI*kv[d]/n[d];
+                D[d] = GpuComplex<Real>((std::cos(th)-1.)/dx[d], std::sin(th)/dx[d]);
+                K2 += D[d].real()*D[d].real() + D[d].imag()*D[d].imag();
+            }
+
+            const GpuComplex<Real> g = spec(i,j,k,AMREX_SPACEDIM);
+
+            if (K2 == 0.) {
+                for (int d=0; d<AMREX_SPACEDIM; ++d) {
+                    spec(i,j,k,d) = (a0 > 0.) ? spec(i,j,k,d)*scale/a0
+                                              : GpuComplex<Real>(mean_gpu[d],0.);
+                }
+                spec(i,j,k,AMREX_SPACEDIM) = GpuComplex<Real>(mean_gpu[AMREX_SPACEDIM],0.);
+                return;
+            }
+
+            GpuComplex<Real> Df(0.,0.);
+            for (int d=0; d<AMREX_SPACEDIM; ++d) {
+                Df += D[d]*spec(i,j,k,d);
+            }
+
+            // -D u = g and D G = -K2 give the pressure,
+            const GpuComplex<Real> p = (Df + (a0 + (beta0+cgd)*K2)*g) * (-1./K2);
+
+            // then each face component follows from its momentum equation
+            for (int d=0; d<AMREX_SPACEDIM; ++d) {
+                const GpuComplex<Real> G(-D[d].real(), D[d].imag());
+                spec(i,j,k,d) = (spec(i,j,k,d) - G*p - cgd*G*g) * (scale / (a0 + beta0*K2));
+            }
+            spec(i,j,k,AMREX_SPACEDIM) = p*scale;
+        });
+    }
+
+    plan.fft->backward(phi_fft, phi);
+    phi.FillBoundary(geom.periodicity());
+
+    // the face box also covers face hi+1, which lives in the neighbour's cell
+    for (int d=0; d<AMREX_SPACEDIM; ++d) {
+        for (MFIter mfi(x_u[d], TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+            const Box& bx = mfi.tilebox();
+            Array4<Real const> const& ph = phi.const_array(mfi);
+            Array4<Real> const& xu = x_u[d].array(mfi);
+            amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                xu(i,j,k) = ph(i,j,k,d);
+            });
+        }
+    }
+    MultiFab::Copy(x_p, phi, AMREX_SPACEDIM, 0, 1, 0);
+    x_p.FillBoundary(geom.periodicity());
+#else
+    amrex::ignore_unused(b_u,b_p,x_u,x_p,alpha_fc,beta,theta_alpha,geom);
+    Abort("StokesFFTSolve: requires USE_FFT=TRUE");
+#endif
+}
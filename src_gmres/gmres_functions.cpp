@@ -36,6 +36,8 @@ int         gmres::gmres_max_inner;
 int         gmres::gmres_max_iter;
 int         gmres::gmres_min_iter;
 int         gmres::gmres_spatial_order;
+int         gmres::gmres_type;
+int         gmres::stokes_fft;
 
 void InitializeGmresNamespace() {
 
@@ -82,6 +84,8 @@ void InitializeGmresNamespace() {
     stag_mg_minwidth = 2;            // length of box at coarsest multigrid level
     stag_mg_bottom_solver = 0;       // bottom solver type
     // 0 = smooths only, controlled by mg_nsmooths_bottom
+    // 1 = BiCGStab on the coarsest level, at most stag_mg_nsmooths_bottom iterations
+    // 4 = gather the coarsest level onto one grid and keep coarsening (stag_mg_max_bottom_nlevels)
     stag_mg_nsmooths_down = 2;       // number of smooths at each level on the way down
     stag_mg_nsmooths_up = 2;         // number of smooths at each level on the way up
     stag_mg_nsmooths_bottom = 8;     // number of smooths at the bottom
@@ -101,6 +105,16 @@ void InitializeGmresNamespace() {
 
     gmres_spatial_order = 2;   // spatial order of viscous and gradient operators in matrix "A"
 
+    // Krylov engine used by GMRES::Solve
+    // 0 = classical GMRES; modified Gram-Schmidt, one reduction per inner product
+    // 1 = single-reduction GMRES; fused block inner products, one MPI reduction per inner iteration
+    gmres_type = 0;
+
+    // advanceStokes solver
+    // 0 = always GMRES
+    // 1 = direct FFT solve when fully periodic with constant coefficients
+    stokes_fft = 1;
+
     ParmParse pp;
 
     // pp.query searches for optional parameters
@@ -141,5 +155,7 @@ void InitializeGmresNamespace() {
     pp.query("gmres_max_iter",gmres_max_iter);
     pp.query("gmres_min_iter",gmres_min_iter);
     pp.query("gmres_spatial_order",gmres_spatial_order);
+    pp.query("gmres_type",gmres_type);
+    pp.query("stokes_fft",stokes_fft);
 
 }
@@ -83,28 +83,29 @@ void StochMomFlux::fillMomStochastic() {
         switch(stoch_stress_form) {
 
         case 0: // Non-symmetric
-            for (int n=0; n<AMREX_SPACEDIM; ++n) {
-                MultiFabFillRandom(mflux_cc[i],n,1.0,geom);
-            }
+            MultiFabFillRandomFused(mflux_cc[i],0,AMREX_SPACEDIM,1.0,geom,true);
 
             for (int d=0; d<NUM_EDGE; ++d) {
-                for (int n=0; n<ncomp_ed; ++n) {
-                    MultiFabFillRandom(mflux_ed[i][d],n,1.0,geom);
-                }
+                MultiFabFillRandomFused(mflux_ed[i][d],0,ncomp_ed,1.0,geom,true);
             }
             break;
 
         default: // Symmetric
-            for (int n=0; n<AMREX_SPACEDIM; ++n) {
-                MultiFabFillRandom(mflux_cc[i],n,2.0,geom);
-            }
+            MultiFabFillRandomFused(mflux_cc[i],0,AMREX_SPACEDIM,2.0,geom,true);
 
             for (int d=0; d<NUM_EDGE; ++d) {
-                MultiFabFillRandom(mflux_ed[i][d],0,1.0,geom);
+                MultiFabFillRandomFused(mflux_ed[i][d],0,1,1.0,geom,true);
+                // the exchange only touches ghost cells of component 0
                 MultiFab::Copy(mflux_ed[i][d], mflux_ed[i][d], 0, 1, ncomp_ed-1, 0);
             }
             break;
         }
+
+        // ghost exchanges above overlap with generation of the following fields
+        mflux_cc[i].FillBoundary_finish();
+        for (int d=0; d<NUM_EDGE; ++d) {
+            mflux_ed[i][d].FillBoundary_finish();
+        }
     }
 }
 
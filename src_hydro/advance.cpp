@@ -81,10 +81,16 @@ void advanceStokes(std::array< MultiFab, AMREX_SPACEDIM >& umac,
         }
     }
 
-    // call GMRES
-    GMRES gmres(ba,dmap,geom);
-    gmres.Solve(gmres_rhs_u,gmres_rhs_p,umac,pres,
-                alpha_fc,beta,beta_ed,gamma,theta_alpha,geom,norm_pre_rhs);
+    if (StokesFFTAvailable(alpha_fc,beta,beta_ed,theta_alpha,geom)) {
+        // periodic with constant coefficients: exact solve in Fourier space
+        StokesFFTSolve(gmres_rhs_u,gmres_rhs_p,umac,pres,alpha_fc,beta,theta_alpha,geom);
+    }
+    else {
+        // call GMRES
+        GMRES gmres(ba,dmap,geom);
+        gmres.Solve(gmres_rhs_u,gmres_rhs_p,umac,pres,
+                    alpha_fc,beta,beta_ed,gamma,theta_alpha,geom,norm_pre_rhs);
+    }
 
     for (int i=0; i<AMREX_SPACEDIM; i++) {
         MultiFabPhysBCDomainVel(umac[i], geom, i);
@@ -0,0 +1,143 @@
+/*
+ * lattice_index.h
+ *
+ *  bucket index for point data living on a regular lattice.
+ *  used by spatial_storage for samplers whose support is one lattice cell
+ *  (e.g. sampler_kmc_fhd), so that a query is a direct lookup instead of a
+ *  scan over the bins covering the support.
+ */
+
+#ifndef MUI_LATTICE_INDEX_H_
+#define MUI_LATTICE_INDEX_H_
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "config.h"
+
+namespace mui {
+
+// a sampler is lattice-aware if it provides lattice_spacing(), within(dx)
+// and reduce(sum,n); see sampler_kmc_fhd.
+template<typename SAMPLER, typename = void>
+struct is_lattice_sampler : std::false_type {};
+template<typename SAMPLER>
+struct is_lattice_sampler<SAMPLER, decltype((void)std::declval<const SAMPLER&>().lattice_spacing())> : std::true_type {};
+
+template<typename CONFIG>
+class lattice_index {
+public:
+    using REAL       = typename CONFIG::REAL;
+    using point_type = typename CONFIG::point_type;
+    static const std::size_t D = CONFIG::D;
+
+    // cells of the lattice are [o+(c-eps)h, o+(c+1-eps)h) with o = focus - h/2,
+    // i.e. the support of a sampler_kmc_fhd centered on focus is exactly cell 0.
+    template<typename T>
+    lattice_index( const std::vector<std::pair<point_type,T> >& pts, const point_type& focus,
+                   const point_type& h, const REAL eps ) : h_(h), eps_(eps), usable_(false) {
+        for( std::size_t d = 0; d < D; ++d ) o_[d] = focus[d] - REAL(0.5) * h[d];
+
+        std::vector<std::array<long long,D> > key(pts.size());
+        std::array<long long,D> kmax;
+        for( std::size_t d = 0; d < D; ++d ) { lo_[d] = 0; kmax[d] = -1; }
+        for( std::size_t i = 0; i < pts.size(); ++i ) {
+            for( std::size_t d = 0; d < D; ++d ) {
+                key[i][d] = cell_of_(pts[i].first[d], d);
+                if( i == 0 || key[i][d] < lo_[d] ) lo_[d] = key[i][d];
+                if( i == 0 || key[i][d] > kmax[d] ) kmax[d] = key[i][d];
+            }
+        }
+
+        // a dense table only pays off if the points really fill a lattice;
+        // scattered data falls back to the bin query
+        std::size_t ncell = 1;
+        for( std::size_t d = 0; d < D; ++d ) {
+            n_[d] = std::size_t(kmax[d] - lo_[d] + 1);
+            ncell *= n_[d];
+            if( ncell > 8*pts.size() + 1024 ) return;
+        }
+
+        // counting sort of the point indices by cell, keeping the input order
+        start_.assign(ncell+1, 0);
+        std::vector<std::size_t> cell(pts.size());
+        for( std::size_t i = 0; i < pts.size(); ++i ) {
+            std::size_t c = 0, stride = 1;
+            for( std::size_t d = 0; d < D; ++d ) {
+                c += std::size_t(key[i][d] - lo_[d]) * stride;
+                stride *= n_[d];
+            }
+            cell[i] = c;
+            start_[c+1]++;
+        }
+        for( std::size_t c = 0; c < ncell; ++c ) start_[c+1] += start_[c];
+        index_.resize(pts.size());
+        std::vector<std::size_t> pos(start_.begin(), start_.end()-1);
+        for( std::size_t i = 0; i < pts.size(); ++i ) index_[pos[cell[i]]++] = i;
+
+        usable_ = true;
+    }
+
+    bool usable() const { return usable_; }
+    bool matches( const point_type& h, const REAL eps ) const {
+        if( eps != eps_ ) return false;
+        for( std::size_t d = 0; d < D; ++d ) if( h[d] != h_[d] ) return false;
+        return true;
+    }
+
+    // same result as SAMPLER::filter() over all points, but only the (at most
+    // 2^D) cells overlapping the support are visited and nothing is allocated.
+    template<typename T, typename SAMPLER>
+    typename SAMPLER::OTYPE query( const std::vector<std::pair<point_type,T> >& pts,
+                                   const point_type& focus, const SAMPLER& s ) const {
+        std::array<long long,D> clo, chi;
+        for( std::size_t d = 0; d < D; ++d ) {
+            clo[d] = cell_of_(focus[d] - (REAL(0.5) + eps_) * h_[d], d);
+            chi[d] = cell_of_(focus[d] + (REAL(0.5) - eps_) * h_[d], d);
+            if( clo[d] < lo_[d] ) clo[d] = lo_[d];
+            if( chi[d] > lo_[d] + (long long)(n_[d]) - 1 ) chi[d] = lo_[d] + (long long)(n_[d]) - 1;
+            if( clo[d] > chi[d] ) return s.reduce(typename SAMPLER::OTYPE(0), 0);
+        }
+
+        typename SAMPLER::OTYPE vsum(0);
+        typename SAMPLER::INT n(0);
+        std::array<long long,D> c = clo;
+        for(;;) {
+            std::size_t cc = 0, stride = 1;
+            for( std::size_t d = 0; d < D; ++d ) {
+                cc += std::size_t(c[d] - lo_[d]) * stride;
+                stride *= n_[d];
+            }
+            for( std::size_t k = start_[cc]; k < start_[cc+1]; ++k ) {
+                const auto& pv = pts[index_[k]];
+                if( s.within(pv.first - focus) ) {
+                    vsum += pv.second;
+                    n++;
+                }
+            }
+            std::size_t d = 0;
+            for( ; d < D && ++c[d] > chi[d]; ++d ) c[d] = clo[d];
+            if( d == D ) break;
+        }
+        return s.reduce(vsum, n);
+    }
+
+private:
+    long long cell_of_( const REAL x, const std::size_t d ) const {
+        return (long long)(std::floor((x - o_[d]) / h_[d] + eps_));
+    }
+
+    point_type o_, h_;
+    REAL eps_;
+    bool usable_;
+    std::array<long long,D> lo_;
+    std::array<std::size_t,D> n_;
+    std::vector<std::size_t> start_;
+    std::vector<std::size_t> index_;
+};
+
+}
+
+#endif /* MUI_LATTICE_INDEX_H_ */
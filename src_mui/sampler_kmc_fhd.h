@@ -31,19 +31,30 @@ namespace mui {
             INT n(0);
             OTYPE vsum(0);
             for(INT i = 0 ; i < data_points.size() ; i++) {
-                point_type dx = data_points[i].first - focus;
-                bool within = true;
-                for(INT i = 0 ; within && i < CONFIG::D ; i++ ) {
-                    within = within && ( dx[i] >= -(0.5 + eps) * bbox[i] && dx[i] < (0.5 - eps) * bbox[i] );
-                }
-                if ( within ) {
+                if ( within( data_points[i].first - focus ) ) {
                     vsum += data_points[i].second;
                     n++;
                 }
             }
+            return reduce( vsum, n );
+        }
+
+        // the pieces of filter(), also used by the lattice_index path of
+        // spatial_storage (see uniface::fetch)
+        inline bool within( const point_type& dx ) const {
+            bool in = true;
+            for(INT i = 0 ; in && i < CONFIG::D ; i++ ) {
+                in = in && ( dx[i] >= -(0.5 + eps) * bbox[i] && dx[i] < (0.5 - eps) * bbox[i] );
+            }
+            return in;
+        }
+        inline OTYPE reduce( OTYPE vsum, INT n ) const {
             if (CONFIG::DEBUG) assert( n!=0 );
             return n ? vsum: OTYPE(-1);
         }
+        inline const point_type& lattice_spacing() const {
+            return bbox;
+        }
 
         inline geometry::any_shape<CONFIG> support( point_type focus ) const {
             return geometry::box<CONFIG>( focus - (0.5 + eps) * bbox, focus + (0.5 + eps) * bbox );
@@ -8,8 +8,10 @@
 #define SPATIAL_STORAGE_H
 
 #include <exception>
+#include <memory>
 #include <mutex>
 #include "dynstorage.h"
+#include "lattice_index.h"
 #include "virtual_container.h"
 
 namespace mui {
@@ -60,6 +62,7 @@ public:
 
     void swap( spatial_storage& rhs ) noexcept(noexcept(BIN(std::move(rhs.bin_)))) {
         data_.swap(rhs.data_);
+        lattice_.swap(rhs.lattice_);
         if( is_bin_ && rhs.is_bin_ ) bin_.swap(rhs.bin_);
         else if( is_bin_ && !rhs.is_bin_ ) {
             ::new(&(rhs.bin_)) BIN(std::move(bin_));
@@ -114,14 +117,43 @@ public:
         }
         return query(reg, f, s);
     }
+    // for lattice-aware samplers (sampler_kmc_fhd): the points are bucketed
+    // once into a lattice_index with the sampler's spacing, and every query
+    // after that only looks at the cells overlapping its support.
+    // thread-safe like build_and_query_ts.
+    template<typename FOCUS, typename SAMPLER>
+    typename SAMPLER::OTYPE
+    lattice_query_ts(const FOCUS& f, const SAMPLER& s) {
+        using vec = std::vector<std::pair<point_type,typename SAMPLER::ITYPE> >;
+        if( data_.empty() ) return s.reduce(typename SAMPLER::OTYPE(0), 0);
+        const vec& st = storage_cast<const vec&>(data_);
+        std::shared_ptr<const lattice_index<CONFIG> > lat;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if( !lattice_ || !lattice_->matches(s.lattice_spacing(), SAMPLER::eps) )
+                lattice_ = std::make_shared<const lattice_index<CONFIG> >(st, f, s.lattice_spacing(), SAMPLER::eps);
+            lat = lattice_;
+        }
+        if( !lat->usable() ) return build_and_query_ts(s.support(f).bbox(), f, s);
+        return lat->query(st, f, s);
+    }
     void insert( storage_t storage ) {
         destroy_if_bin_();
+        lattice_.reset();
         if( !storage ) return;
         if( !data_ ) data_ = std::move(storage);
         else if( data_.which() == storage.which() ) data_.apply_visitor(insert_{storage});
         else EXCEPTION(bad_storage_id("spatial storage: insert error. Type doesn't match."));
     }
 
+    // raw (point,value) pairs, for callers that bin the data themselves
+    template<typename T>
+    const std::vector<std::pair<point_type,T> >& points() const {
+        static const std::vector<std::pair<point_type,T> > none;
+        if( data_.empty() ) return none;
+        return storage_cast<const std::vector<std::pair<point_type,T> >&>(data_);
+    }
+
     bool is_built() const { return is_bin_; }
     bool empty() const { return data_.empty(); }
 private:
@@ -140,6 +172,7 @@ private:
         BIN bin_;
     };
     mutable std::mutex mutex_;
+    std::shared_ptr<const lattice_index<CONFIG> > lattice_;
 };
 }
 
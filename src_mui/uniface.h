@@ -8,6 +8,9 @@
 #ifndef UNIFACE_H_
 #define UNIFACE_H_
 
+#include <array>
+#include <vector>
+
 #include "util.h"
 #include "comm.h"
 #include "comm_factory.h"
@@ -153,11 +156,78 @@ public:
             time_type time = first->first;
             auto iter = first->second.find(attr);
             if( iter == first->second.end() ) continue;
-            v.emplace_back(time,iter->second.build_and_query_ts(sampler.support(focus).bbox(),focus,sampler));
+            v.emplace_back(time,query_(iter->second,focus,sampler,is_lattice_sampler<SAMPLER>{}));
         }
         return t_sampler.filter(t, v);
     }
 
+    // push_grid() pushes a whole structured array in one call. values[c] with
+    // c = i0 + n[0]*(i1 + n[1]*(...)) is placed at the cell center lo + (i+0.5)*h.
+    // the data on the wire is identical to one push() per cell.
+    template<typename TYPE>
+    void push_grid( const std::string& attr, const point_type& lo, const point_type& h,
+                    const std::array<std::size_t,CONFIG::D>& n, const std::vector<TYPE>& values ) {
+        storage_t& st = push_buffer[attr];
+        if( !st ) st = storage_t(std::vector<std::pair<point_type,TYPE> >());
+        auto& v = storage_cast<std::vector<std::pair<point_type,TYPE> >&>(st);
+        v.reserve(v.size() + values.size());
+        std::array<std::size_t,CONFIG::D> idx{};
+        for( std::size_t c = 0; c < values.size(); ++c ) {
+            point_type loc;
+            for( std::size_t d = 0; d < CONFIG::D; ++d ) loc[d] = lo[d] + (idx[d] + 0.5) * h[d];
+            v.emplace_back( loc, values[c] );
+            for( std::size_t d = 0; d < CONFIG::D && ++idx[d] == n[d]; ++d ) idx[d] = 0;
+        }
+    }
+
+    // fetch_grid() is the bulk counterpart of fetch() with sampler_kmc_fhd:
+    // every received point is binned once into the cell of the structured array
+    // (lo, h, n) that contains it, and the per-cell sums are then filtered in time.
+    // cells without any point get TYPE(-1), like sampler_kmc_fhd.
+    // the cost is linear in the number of received points plus cells.
+    template<typename TYPE, class TIME_SAMPLER>
+    std::vector<TYPE> fetch_grid( const std::string& attr, const point_type& lo, const point_type& h,
+                                  const std::array<std::size_t,CONFIG::D>& n, const time_type t,
+                                  const TIME_SAMPLER& t_sampler, const REAL eps = 1e-6 ) {
+        barrier(t_sampler.get_upper_bound(t));
+
+        std::size_t ncell = 1;
+        for( std::size_t d = 0; d < CONFIG::D; ++d ) ncell *= n[d];
+
+        std::vector<std::vector<std::pair<time_type,TYPE> > > v(ncell);
+        std::vector<TYPE> sum(ncell);
+        std::vector<int> cnt(ncell);
+
+        for( auto first=log.lower_bound(t_sampler.get_lower_bound(t)),
+             last = log.upper_bound(t_sampler.get_upper_bound(t)); first!= last; ++first ){
+            time_type time = first->first;
+            auto iter = first->second.find(attr);
+            if( iter == first->second.end() ) continue;
+
+            std::fill(sum.begin(), sum.end(), TYPE(0));
+            std::fill(cnt.begin(), cnt.end(), 0);
+            for( const auto& pv: iter->second.template points<TYPE>() ) {
+                std::size_t c = 0, stride = 1;
+                bool inside = true;
+                for( std::size_t d = 0; inside && d < CONFIG::D; ++d ) {
+                    REAL r = (pv.first[d] - lo[d]) / h[d] + eps;
+                    inside = ( r >= 0 && r < REAL(n[d]) );
+                    if( !inside ) break;
+                    c += std::size_t(r) * stride;
+                    stride *= n[d];
+                }
+                if( !inside ) continue;
+                sum[c] += pv.second;
+                cnt[c]++;
+            }
+            for( std::size_t c = 0; c < ncell; ++c ) v[c].emplace_back(time, cnt[c] ? sum[c] : TYPE(-1));
+        }
+
+        std::vector<TYPE> out(ncell);
+        for( std::size_t c = 0; c < ncell; ++c ) out[c] = t_sampler.filter(t, v[c]);
+        return out;
+    }
+
     // commit() serializes pushed data and send it to remote nodes and, after that,
     // send "confirm" message.
     // return actual number of peers contacted
@@ -230,6 +300,16 @@ private:
         if( m.has_id() ) readers[m.id()](m);
     }
 
+    // spatial query of one frame; lattice-aware samplers use the lattice index
+    template<class SAMPLER>
+    typename SAMPLER::OTYPE query_( spatial_t& st, const point_type& focus, const SAMPLER& sampler, std::false_type ) {
+        return st.build_and_query_ts(sampler.support(focus).bbox(),focus,sampler);
+    }
+    template<class SAMPLER>
+    typename SAMPLER::OTYPE query_( spatial_t& st, const point_type& focus, const SAMPLER& sampler, std::true_type ) {
+        return st.lattice_query_ts(focus,sampler);
+    }
+
     void on_recv_confirm( int32_t sender, time_type timestamp ) {
         peers.at(sender).set_current_t(timestamp);
     }
@@ -57,9 +57,10 @@ void StochMassFlux::fillMassStochastic() {
 
     for (int i=0; i<n_rngs; ++i) {
         for (int n=0; n<AMREX_SPACEDIM; ++n) {
-            for (int comp=0; comp<nspecies; comp++) {
-                MultiFabFillRandom(stoch_W_fc[i][n],comp,1.0,geom);
-            }
+            MultiFabFillRandomFused(stoch_W_fc[i][n],0,nspecies,1.0,geom,true);
+        }
+        for (int n=0; n<AMREX_SPACEDIM; ++n) {
+            stoch_W_fc[i][n].FillBoundary_finish();
         }
     }
 }
@@ -146,7 +146,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
     }
 
-    void FhdParticleContainer::MoveParticlesCPP(const Real dt, paramPlane* paramPlaneList, const int paramPlaneCount)
+    void FhdParticleContainer::MoveParticlesCPP(const Real dt, paramPlane* paramPlaneList, const int paramPlaneCount, const iMultiFab* planeCell)
     {
         BL_PROFILE_VAR("MoveParticlesCPP()", MoveParticlesCPP);
 
@@ -154,6 +154,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
         const GpuArray<Real, 3> dx = Geom(lev).CellSizeArray();
         const GpuArray<Real, 3> plo = Geom(lev).ProbLoArray();
         const GpuArray<Real, 3> phi = Geom(lev).ProbHiArray();
+        const GpuArray<Real, 3> dxInv = Geom(lev).InvCellSizeArray();
 
         int np_tile = 0, np_proc = 0;
 
@@ -204,6 +205,9 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
             totalParts += np;
 
+            const bool indexed = (planeCell != nullptr);
+            const Array4<const int> planeCellArr = indexed ? planeCell->const_array(pti) : Array4<const int>();
+
     //        for (int i = 0; i < np; i++)
             amrex::ParallelForRNG(np, [=] AMREX_GPU_DEVICE (int i, amrex::RandomEngine const& engine) noexcept
             {
@@ -219,8 +223,16 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
                 while(runtime > 0)
                 {
-                    find_inter_gpu(part, runtime, paramPlaneListPtr, paramPlaneCount,
-                        &intsurf, &inttime, &intside, AMREX_ZFILL(plo), AMREX_ZFILL(phi));
+                    if(indexed)
+                    {
+                        find_inter_indexed_gpu(part, runtime, paramPlaneListPtr, paramPlaneCount, planeCellArr, dxInv,
+                            &intsurf, &inttime, &intside, AMREX_ZFILL(plo), AMREX_ZFILL(phi));
+                    }
+                    else
+                    {
+                        find_inter_gpu(part, runtime, paramPlaneListPtr, paramPlaneCount,
+                            &intsurf, &inttime, &intside, AMREX_ZFILL(plo), AMREX_ZFILL(phi));
+                    }
 
                     for (int d=0; d<(AMREX_SPACEDIM); ++d)
                     //for (int d=0; d<(AMREX_SPACEDIM-2); ++d)
@@ -325,7 +337,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
         SortParticlesDB();
     }
 
-    void FhdParticleContainer::MovePhononsCPP(const Real dt, paramPlane* paramPlaneList, const int paramPlaneCount, const int step, const int istep, iMultiFab& bCell)
+    void FhdParticleContainer::MovePhononsCPP(const Real dt, paramPlane* paramPlaneList, const int paramPlaneCount, const int step, const int istep, iMultiFab& bCell, const iMultiFab* planeCell)
     {
         BL_PROFILE_VAR("MoveParticlesCPP()", MoveParticlesCPP);
 
@@ -333,6 +345,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
         const GpuArray<Real, 3> dx = Geom(lev).CellSizeArray();
         const GpuArray<Real, 3> plo = Geom(lev).ProbLoArray();
         const GpuArray<Real, 3> phi = Geom(lev).ProbHiArray();
+        const GpuArray<Real, 3> dxInv = Geom(lev).InvCellSizeArray();
 
         int np_tile = 0, np_proc = 0, scatterCount = 0, count = 0, specCount = 0;
 
@@ -392,6 +405,9 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
             Array4<int> bCellArr  = bCell[pti].array();
 
+            const bool indexed = (planeCell != nullptr);
+            const Array4<const int> planeCellArr = indexed ? planeCell->const_array(pti) : Array4<const int>();
+
             Box bx  = pti.tilebox();
             IntVect myLo = bx.smallEnd();
             IntVect myHi = bx.bigEnd();
@@ -431,9 +447,16 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
                     if(bCellArr(cell[0],cell[1],cell[2]) != 1)
                     {
-
-                        find_inter_gpu(part, runtime, paramPlaneListPtr, paramPlaneCount,
-                            &intsurf, &inttime, &intside, AMREX_ZFILL(plo), AMREX_ZFILL(phi));
+                        if(indexed)
+                        {
+                            find_inter_indexed_gpu(part, runtime, paramPlaneListPtr, paramPlaneCount, planeCellArr, dxInv,
+                                &intsurf, &inttime, &intside, AMREX_ZFILL(plo), AMREX_ZFILL(phi));
+                        }
+                        else
+                        {
+                            find_inter_gpu(part, runtime, paramPlaneListPtr, paramPlaneCount,
+                                &intsurf, &inttime, &intside, AMREX_ZFILL(plo), AMREX_ZFILL(phi));
+                        }
                     }
 
 
@@ -736,6 +759,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
     void FhdParticleContainer::SortParticlesDB()
     {
+        BL_PROFILE_VAR("SortParticlesDB()",SortParticlesDB);
 
         int lev = 0;
 
@@ -779,9 +803,49 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
     //
     //        }
     //        Print() << "np: " << np << ", nbins: " << nbins << ", ncells: " << ncells << endl;
-        m_bins.build(np, pstruct_ptr, nbins, getBin{plo, dxInv, tile_box, ncells});
+            const getBin binner{plo, dxInv, tile_box, ncells};
+
+            // most steps only a few particles change cell, so patch the bins
+            // in place; the sorted layout wants the full permutation instead
+            if(dsmc_sorted_layout == 0 && dsmc_rebin_fraction > 0. &&
+               RebinIncremental(grid_id, tile_id, binner, nbins))
+            {
+                continue;
+            }
+
+        m_bins.build(np, pstruct_ptr, nbins, binner);
             auto inds = m_bins.permutationPtr();
             auto offs = m_bins.offsetsPtr();
+
+            // move the particles into bin order, so that each (species, cell) list is a
+            // contiguous range of the tile and the permutation becomes the identity;
+            // collisions and stats then read neighbouring particles instead of gathering
+            if(dsmc_sorted_layout == 1 && np > 0)
+            {
+                Gpu::DeviceVector<ParticleType> sorted(np);
+                ParticleType* psorted = sorted.dataPtr();
+
+                amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+                {
+                    psorted[i] = pstruct_ptr[inds[i]];
+                    inds[i] = i;
+                });
+                amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+                {
+                    pstruct_ptr[i] = psorted[i];
+                });
+                Gpu::streamSynchronize();
+            }
+
+            // the padded lists only pay off if they are patched later
+            if(dsmc_sorted_layout == 0 && dsmc_rebin_fraction > 0.)
+            {
+                RebinFull(grid_id, tile_id, binner, nbins);
+            }
+            else
+            {
+                m_bin_nbins = -1;
+            }
     //
             if(ParallelDescriptor::MyProc()==1)
             {
@@ -822,6 +886,141 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
     }
 
+    // copy m_bins into the slack-padded lists returned by getBins()
+    void FhdParticleContainer::RebinFull(const int grid_id, const int tile_id, const getBin& binner, const int nbins)
+    {
+        auto& particles = GetParticles(0)[std::make_pair(grid_id,tile_id)].GetArrayOfStructs();
+        const long np = particles.numParticles();
+        const auto pstruct_ptr = particles().dataPtr();
+        const auto inds = m_bins.permutationPtr();
+        const auto offs = m_bins.offsetsPtr();
+
+        // a quarter of each list (at least two slots) is kept free for arrivals
+        m_bin_start.resize(nbins+1);
+        m_bin_count.resize(nbins);
+        m_bin_dirty.resize(nbins);
+        unsigned int* start = m_bin_start.dataPtr();
+        unsigned int* count = m_bin_count.dataPtr();
+        int* dirty = m_bin_dirty.dataPtr();
+
+        amrex::ParallelFor(nbins, [=] AMREX_GPU_DEVICE (int b) noexcept
+        {
+            count[b] = offs[b+1]-offs[b];
+            start[b] = count[b] + count[b]/4 + 2;
+            dirty[b] = 0;
+        });
+        Gpu::exclusive_scan(m_bin_start.begin(), m_bin_start.end(), m_bin_start.begin());
+
+        unsigned int nslots;
+        Gpu::copy(Gpu::deviceToHost, m_bin_start.begin()+nbins, m_bin_start.end(), &nslots);
+
+        m_bin_perm.resize(nslots);
+        m_bin_of.resize(np);
+        m_bin_new.resize(np);
+        m_bin_pid.resize(np);
+        m_bin_cpu.resize(np);
+        unsigned int* perm = m_bin_perm.dataPtr();
+        unsigned int* bin_of = m_bin_of.dataPtr();
+        Long* pid = m_bin_pid.dataPtr();
+        int* cpu = m_bin_cpu.dataPtr();
+
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int k) noexcept
+        {
+            const unsigned int p = inds[k];
+            const unsigned int b = binner(pstruct_ptr[p]);
+            perm[start[b] + k - offs[b]] = p;
+            bin_of[p] = b;
+            pid[k] = pstruct_ptr[k].id();
+            cpu[k] = pstruct_ptr[k].cpu();
+        });
+
+        m_bin_box = binner.domain;
+        m_bin_grid = grid_id;
+        m_bin_tile = tile_id;
+        m_bin_nbins = nbins;
+    }
+
+    // move the particles that changed bin since the last sort; returns false
+    // (bins untouched or inconsistent) when the caller has to rebuild instead
+    bool FhdParticleContainer::RebinIncremental(const int grid_id, const int tile_id, const getBin& binner, const int nbins)
+    {
+        auto& particles = GetParticles(0)[std::make_pair(grid_id,tile_id)].GetArrayOfStructs();
+        const long np = particles.numParticles();
+
+        if(grid_id != m_bin_grid || tile_id != m_bin_tile || nbins != m_bin_nbins ||
+           binner.domain != m_bin_box || np != (long)m_bin_of.size())
+        {
+            return false;
+        }
+        if(np == 0) return true;
+
+        const auto pstruct_ptr = particles().dataPtr();
+        unsigned int* perm = m_bin_perm.dataPtr();
+        unsigned int* start = m_bin_start.dataPtr();
+        unsigned int* count = m_bin_count.dataPtr();
+        unsigned int* bin_of = m_bin_of.dataPtr();
+        unsigned int* bin_new = m_bin_new.dataPtr();
+        const Long* pid = m_bin_pid.dataPtr();
+        const int* cpu = m_bin_cpu.dataPtr();
+        int* dirty = m_bin_dirty.dataPtr();
+
+        // Redistribute removes, appends and reorders particles, so the lists
+        // only carry over if every slot still holds the same particle
+        ReduceOps<ReduceOpSum, ReduceOpSum> reduce_op;
+        ReduceData<Long, Long> reduce_data(reduce_op);
+        using ReduceTuple = typename decltype(reduce_data)::Type;
+        reduce_op.eval(np, reduce_data,
+        [=] AMREX_GPU_DEVICE (int i) -> ReduceTuple
+        {
+            const ParticleType& p = pstruct_ptr[i];
+            const Long moved = (Long(p.id()) != pid[i] || int(p.cpu()) != cpu[i]) ? 1 : 0;
+            const unsigned int b = binner(p);
+            bin_new[i] = b;
+            if(b == bin_of[i]) return {moved, 0};
+            dirty[bin_of[i]] = 1;
+            return {moved, 1};
+        });
+        const auto counts = reduce_data.value(reduce_op);
+        const Long nchanged = amrex::get<1>(counts);
+
+        if(amrex::get<0>(counts) > 0 || nchanged > dsmc_rebin_fraction*np) return false;
+        if(nchanged == 0) return true;
+
+        // drop the leavers from their old lists
+        amrex::ParallelFor(nbins, [=] AMREX_GPU_DEVICE (int b) noexcept
+        {
+            if(dirty[b] == 0) return;
+            unsigned int w = 0;
+            for(unsigned int k=0; k<count[b]; k++)
+            {
+                const unsigned int p = perm[start[b]+k];
+                if(bin_new[p] == (unsigned int)b) perm[start[b]+(w++)] = p;
+            }
+            count[b] = w;
+            dirty[b] = 0;
+        });
+
+        // and append them to the new ones
+        Gpu::DeviceScalar<int> overflow_d(0);
+        int* overflow = overflow_d.dataPtr();
+        amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (int i) noexcept
+        {
+            const unsigned int b = bin_new[i];
+            if(b == bin_of[i]) return;
+            const unsigned int k = Gpu::Atomic::Add(&count[b], 1u);
+            if(start[b]+k < start[b+1])
+            {
+                perm[start[b]+k] = i;
+            }else
+            {
+                *overflow = 1;
+            }
+            bin_of[i] = b;
+        });
+
+        return overflow_d.dataValue() == 0;
+    }
+
     //void FhdParticleContainer::SpecChange(FhdParticleContainer::ParticleType& part) {
     //    int lev = 0;
     //    bool proc_enter = true;
@@ -1820,8 +2019,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
             const Array4<Real> & arrvrmax = mfvrmax.array(mfi);
             const Array4<Real> & arrselect = mfselect.array(mfi);
 
-            auto inds = m_bins.permutationPtr();
-            auto offs = m_bins.offsetsPtr();
+            const DsmcBinsView bins = getBins();
             //const long np = particles.numParticles();
             //amrex::ParallelForRNG(tile_box,
             //    [=] AMREX_GPU_DEVICE (int i, int j, int k, amrex::RandomEngine const& engine) noexcept {
@@ -1846,8 +2044,8 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
                 for(int i_spec = 0; i_spec<nspecies; i_spec++)
                 {
-                    unsigned int* cellList = getCellList(inds,offs,iv,i_spec,tile_box);
-                    np[i_spec] = getBinSize(offs,iv,i_spec,tile_box);
+                    unsigned int* cellList = getCellList(bins,iv,i_spec,tile_box);
+                    np[i_spec] = getBinSize(bins,iv,i_spec,tile_box);
                     for(int i_cell = 0; i_cell<np[i_spec]; i_cell++)
                     {
                         int pindex = cellList[i_cell];
@@ -1872,7 +2070,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
                 for(int i_spec = 0; i_spec<nspecies; i_spec++)
                 {
-                    unsigned int* cellList = getCellList(inds,offs,iv,i_spec,tile_box);
+                    unsigned int* cellList = getCellList(bins,iv,i_spec,tile_box);
                     for(int i_cell = 0; i_cell<np[i_spec]; i_cell++)
                     {
                         int pindex = cellList[i_cell];
@@ -1887,7 +2085,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
                 }
                 for(int i_spec = 0; i_spec<nspecies; i_spec++)
                 {
-                    unsigned int* cellList = getCellList(inds,offs,iv,i_spec,tile_box);
+                    unsigned int* cellList = getCellList(bins,iv,i_spec,tile_box);
                     for(int i_cell = 0; i_cell<np[i_spec]; i_cell++)
                     {
                         int pindex = cellList[i_cell];
@@ -1904,7 +2102,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom, const Distribu
 
                 for(int i_spec = 0; i_spec<nspecies; i_spec++)
                 {
-                    unsigned int* cellList = getCellList(inds,offs,iv,i_spec,tile_box);
+                    unsigned int* cellList = getCellList(bins,iv,i_spec,tile_box);
                     for(int i_cell = 0; i_cell<np[i_spec]; i_cell++)
                     {
                         int pindex = cellList[i_cell];
@@ -73,6 +73,7 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom,
         meanRadialDistribution_pp = new Real[totalBins]();
         meanRadialDistribution_pm = new Real[totalBins]();
         meanRadialDistribution_mm = new Real[totalBins]();
+        meanRadialDistribution_ij = new Real[nspecies*nspecies*totalBins]();
     }
 
     // storage for mean Cartesian distributions
@@ -91,6 +92,8 @@ FhdParticleContainer::FhdParticleContainer(const Geometry & geom,
         meanZDistribution_pp = new Real[totalBins]();
         meanZDistribution_pm = new Real[totalBins]();
         meanZDistribution_mm = new Real[totalBins]();
+
+        meanCartesianDistribution_ij = new Real[3*nspecies*nspecies*totalBins]();
     }
 
     //Remove files that we will be appending to.
@@ -398,7 +401,11 @@ void FhdParticleContainer::computeForcesNLGPU([[maybe_unused]] const MultiFab& c
     }
 }
 
-void FhdParticleContainer::computeForcesCoulombGPU(long totalParticles) {
+// direct pairwise Coulomb sum (es_tog=2), distributed as a ring:
+// each rank keeps its own particles and the (x,y,z,q) blocks of all ranks are passed
+// around the ranks one step at a time, so no rank ever holds more than two blocks.
+// the work is still O(N^2/nprocs); es_tog=3 (P3M) is the O(N log N) option
+void FhdParticleContainer::computeForcesCoulombGPU([[maybe_unused]] long totalParticles) {
 
     BL_PROFILE_VAR("computeForcesCoulomb()",computeForcesCoulomb);
 
@@ -420,36 +427,34 @@ void FhdParticleContainer::computeForcesCoulombGPU(long totalParticles) {
     domy = (phi[1] - plo[1]);
     domz = (phi[2] - plo[2]);
 
-//    Real posx[totalParticles];
-    Gpu::ManagedVector<Real> posx;
-    posx.resize(totalParticles);
-    Real * posxPtr = posx.dataPtr();
-
-    Gpu::ManagedVector<Real> posy;
-    posy.resize(totalParticles);
-    Real * posyPtr = posy.dataPtr();
+    Print() << "Calculating Coulomb force for each particle pair\n";
 
-    Gpu::ManagedVector<Real> posz;
-    posz.resize(totalParticles);
-    Real * poszPtr = posz.dataPtr();
+    // pack the positions and charges of this rank, 4 reals per particle
+    long nlocal = 0;
+    for (FhdParIter pti(*this, lev); pti.isValid(); ++pti) {
+        nlocal += pti.numParticles();
+    }
 
-    Gpu::ManagedVector<Real> charge;
-    charge.resize(totalParticles);
-    Real * chargePtr = charge.dataPtr();
+    Gpu::DeviceVector<Real> visiting(4*nlocal);
+    Real* pvisiting = visiting.dataPtr();
 
-//    Real posx[totalParticles];
-//    Real posy[totalParticles];
-//    Real posz[totalParticles];
-//    int  species[totalParticles];
-//    Real charge[totalParticles];
+    long offset = 0;
+    for (FhdParIter pti(*this, lev); pti.isValid(); ++pti) {
 
-    Print() << "Calculating Coulomb force for each particle pair\n";
+        auto& particles = pti.GetArrayOfStructs();
+        const int np = particles.numParticles();
+        auto pstruct = particles().dataPtr();
 
-    // collect particle positions onto one processor
-    PullDown(0, posxPtr, -1, totalParticles);
-    PullDown(0, posyPtr, -2, totalParticles);
-    PullDown(0, poszPtr, -3, totalParticles);
-    PullDown(0, chargePtr, FHD_realData::q , totalParticles);
+        AMREX_FOR_1D( np, i,
+        {
+            const ParticleType & part = pstruct[i];
+            pvisiting[4*(offset+i)  ] = part.pos(0);
+            pvisiting[4*(offset+i)+1] = part.pos(1);
+            pvisiting[4*(offset+i)+2] = part.pos(2);
+            pvisiting[4*(offset+i)+3] = part.rdata(FHD_realData::q);
+        });
+        offset += np;
+    }
 
     int imag = (images == 0) ? 1 : images;
 
@@ -457,61 +462,92 @@ void FhdParticleContainer::computeForcesCoulombGPU(long totalParticles) {
                                    //imag * domy,
                                    imag * domz);
 
-    for (FhdParIter pti(*this, lev); pti.isValid(); ++pti) {
+    const int nprocs = ParallelDescriptor::NProcs();
 
-        const int grid_id = pti.index();
-        const int tile_id = pti.LocalTileIndex();
+    for (int ring_step = 0; ring_step < nprocs; ++ring_step) {
 
-        auto& particle_tile = GetParticles(lev)[std::make_pair(grid_id,tile_id)];
-        auto& particles = particle_tile.GetArrayOfStructs();
-        const int np = particles.numParticles();
+        const Real* pblock = visiting.dataPtr();
+        const long nblock = visiting.size()/4;
 
-       auto pstruct = particles().dataPtr();
+        for (FhdParIter pti(*this, lev); pti.isValid(); ++pti) {
 
-        // loop over particles
-//                for(int i = 0; i < np; i++)
-        AMREX_FOR_1D( np, i,
-        {
+            auto& particles = pti.GetArrayOfStructs();
+            const int np = particles.numParticles();
 
-            ParticleType & part = pstruct[i];
+            auto pstruct = particles().dataPtr();
 
-            double dr2;
-            double rtdr2;
-            double dx;
-            double dy;
-            double dz;
+            // loop over particles
+            AMREX_FOR_1D( np, i,
+            {
 
-            Real q1 = part.rdata(FHD_realData::q);
+                ParticleType & part = pstruct[i];
 
-            for(int j = 0; j < totalParticles; j++)
-            {
+                double dr2;
+                double rtdr2;
+                double dx;
+                double dy;
+                double dz;
 
-                 Real q2 = chargePtr[j];
+                Real q1 = part.rdata(FHD_realData::q);
 
-                // (currently hard-coded for y-wall)
-                for(int ii = -images; ii <= images; ii++)
+                for(long j = 0; j < nblock; j++)
                 {
-                       for(int kk = -images; kk <= images; kk++)
-                       {
-
-                          // get distance between particles
-                          dx = part.pos(0)-posxPtr[j] - ii*domx;
-                          dy = part.pos(1)-posyPtr[j];// - jj*domy;
-                          dz = part.pos(2)-poszPtr[j] - kk*domz;
-
-                          dr2 = dx*dx + dy*dy + dz*dz;
-                          rtdr2 = sqrt(dr2);
-
-                            if (rtdr2 < maxdist && rtdr2 > 0.0)
-                          {
-                              part.rdata(FHD_realData::forcex) += ee*(dx/rtdr2)*q1*q2/dr2;
-                              part.rdata(FHD_realData::forcey) += ee*(dy/rtdr2)*q1*q2/dr2;
-                              part.rdata(FHD_realData::forcez) += ee*(dz/rtdr2)*q1*q2/dr2;
-                          }
-                       }
+
+                    Real q2 = pblock[4*j+3];
+
+                    // (currently hard-coded for y-wall)
+                    for(int ii = -images; ii <= images; ii++)
+                    {
+                           for(int kk = -images; kk <= images; kk++)
+                           {
+
+                              // get distance between particles
+                              dx = part.pos(0)-pblock[4*j  ] - ii*domx;
+                              dy = part.pos(1)-pblock[4*j+1];// - jj*domy;
+                              dz = part.pos(2)-pblock[4*j+2] - kk*domz;
+
+                              dr2 = dx*dx + dy*dy + dz*dz;
+                              rtdr2 = sqrt(dr2);
+
+                                if (rtdr2 < maxdist && rtdr2 > 0.0)
+                              {
+                                  part.rdata(FHD_realData::forcex) += ee*(dx/rtdr2)*q1*q2/dr2;
+                                  part.rdata(FHD_realData::forcey) += ee*(dy/rtdr2)*q1*q2/dr2;
+                                  part.rdata(FHD_realData::forcez) += ee*(dz/rtdr2)*q1*q2/dr2;
+                              }
+                           }
+                    }
                 }
-            }
-        });
+            });
+        }
+
+        if (ring_step == nprocs-1) break;
+
+#ifdef AMREX_USE_MPI
+        // pass the visiting block on to the next rank and take the one from the previous rank
+        const int myproc = ParallelDescriptor::MyProc();
+        const int dest = (myproc+1)%nprocs;
+        const int src  = (myproc-1+nprocs)%nprocs;
+        MPI_Comm comm = ParallelDescriptor::Communicator();
+
+        Gpu::HostVector<Real> sendbuf(visiting.size());
+        Gpu::copy(Gpu::deviceToHost, visiting.begin(), visiting.end(), sendbuf.begin());
+        Gpu::streamSynchronize();
+
+        long nsend = sendbuf.size();
+        long nrecv = 0;
+        MPI_Sendrecv(&nsend, 1, MPI_LONG, dest, 0,
+                     &nrecv, 1, MPI_LONG, src,  0, comm, MPI_STATUS_IGNORE);
+
+        Gpu::HostVector<Real> recvbuf(nrecv);
+        MPI_Sendrecv(sendbuf.data(), static_cast<int>(nsend), ParallelDescriptor::Mpi_typemap<Real>::type(), dest, 1,
+                     recvbuf.data(), static_cast<int>(nrecv), ParallelDescriptor::Mpi_typemap<Real>::type(), src,  1,
+                     comm, MPI_STATUS_IGNORE);
+
+        visiting.resize(nrecv);
+        Gpu::copy(Gpu::hostToDevice, recvbuf.begin(), recvbuf.end(), visiting.begin());
+        Gpu::streamSynchronize();
+#endif
     }
 
     Print() << "Finished Coulomb calculation\n";
@@ -1024,10 +1060,6 @@ void FhdParticleContainer::SpreadIonsGPU(const Real* dxFluid, const Geometry geo
     [[maybe_unused]] const Real* plo = Geom(lev).ProbLo();
     [[maybe_unused]] const Real* phi = Geom(lev).ProbHi();
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-
     //for (FhdParIter pti(* this, lev); pti.isValid(); ++pti)
     //{
     //    const int grid_id = pti.index();
@@ -1075,204 +1107,260 @@ void FhdParticleContainer::SpreadIonsGPU(const Real* dxFluid, const Geometry geo
     }
 }
 
-void FhdParticleContainer::RadialDistribution(long totalParticles, const int step, const species* particleInfo)
+// copy the particles into m_stats_pc, whose neighbor layer reaches `reach`, and
+// build its neighbor list; the force neighbor list only spans nghost particle
+// cells, which is usually far short of the g(r) range
+FhdStatsContainer& FhdParticleContainer::UpdateNeighborListForStats(const Real reach)
 {
+    BL_PROFILE_VAR("UpdateNeighborListForStats()",UpdateNeighborListForStats);
+
     const int lev = 0;
-    int bin;
-    double domx, domy, domz, totalDist; [[maybe_unused]] double temp;
 
-    domx = (prob_hi[0] - prob_lo[0]);
-    domy = (prob_hi[1] - prob_lo[1]);
-    domz = (prob_hi[2] - prob_lo[2]);
+    // the list stencil is ncells particle cells in each direction, and two
+    // particles less than ncells*dx apart along an axis are at most ncells cells apart
+    const Real* dxp = Geom(lev).CellSize();
+    const int ncells = (int)amrex::Math::floor(reach/amrex::min(dxp[0],dxp[1],dxp[2])) + 1;
 
-    Real posx[totalParticles];
-    Real posy[totalParticles];
-    Real posz[totalParticles];
-    int  species[totalParticles];
+    if (!m_stats_pc || m_stats_ncells != ncells ||
+        m_stats_pc->ParticleBoxArray(lev) != ParticleBoxArray(lev) ||
+        m_stats_pc->ParticleDistributionMap(lev) != ParticleDistributionMap(lev))
+    {
+        m_stats_pc = std::make_unique<FhdStatsContainer>(Geom(lev), ParticleDistributionMap(lev),
+                                                         ParticleBoxArray(lev), ncells);
+        m_stats_ncells = ncells;
+    }
 
-    Real charge[totalParticles];
+    // same grids, so the local copy needs no redistribution
+    m_stats_pc->copyParticles(*this, true);
+    m_stats_pc->fillNeighbors();
+    m_stats_pc->buildNeighborList(CHECK_PAIR{});
 
-    Print() << "Calculating radial distribution\n";
+    return *m_stats_pc;
+}
 
-    // collect particle positions onto one processor
-    PullDown(0, posx, -1, totalParticles);
-    Print() << "HERE1\n";
-    PullDown(0, posy, -2, totalParticles);
-    Print() << "HERE2\n";
-    PullDown(0, posz, -3, totalParticles);
-    Print() << "HERE3\n";
-    PullDown(0, charge, 27, totalParticles);
-    Print() << "HERE4\n";
-    PullDownInt(0, species, 4, totalParticles);
-    Print() << "HERE5\n";
+// g(r) hit counts per species pair from the neighbor list of each particle, accumulated
+// on the device; acc is laid out as in RadialDistribution: nspecies*nspecies histograms
+// of totalBins, nspecies*nspecies+1 nearest neighbour sums, as many nearest neighbour
+// counts and nspecies particle counts; the caller does the reduction
+void FhdParticleContainer::RadialDistributionNL(RealVector& acc)
+{
+    BL_PROFILE_VAR("RadialDistributionNL()",RadialDistributionNL);
 
-    // outer radial extent
-    totalDist = totalBins*binSize;
+    const int lev = 0;
 
-    // this is the bin "hit count"
-    RealVector radDist   (totalBins, 0.);
-    RealVector radDist_pp(totalBins, 0.);
-    RealVector radDist_pm(totalBins, 0.);
-    RealVector radDist_mm(totalBins, 0.);
+    const int nbins = totalBins;
+    const Real bin_size = binSize;
+    const Real total_dist = totalBins*binSize;
+    const int nspec = nspecies;
+    const int nn_off = nspec*nspec*nbins;
+    const int nc_off = nn_off + nspec*nspec + 1;
+    const int sc_off = nc_off + nspec*nspec + 1;
 
-    double nearest[totalParticles*(nspecies+1)];
-    double nn[nspecies*nspecies+1];
+    FhdStatsContainer& spc = UpdateNeighborListForStats(total_dist);
 
-    for(int k = 0; k < (nspecies+1)*totalParticles; k++)
-    {
-        nearest[k] = 0;
-    }
+    Gpu::DeviceVector<Real> acc_d(acc.size(), 0.);
+    Real* pacc = acc_d.dataPtr();
 
-    for(int k = 0; k < nspecies*nspecies+1; k++)
+    for (FhdParIter pti(spc, lev, MFItInfo().SetDynamic(false)); pti.isValid(); ++pti)
     {
-        nn[k] = 0;
-    }
+        PairIndex index(pti.index(), pti.LocalTileIndex());
+        AoS& particles = pti.GetArrayOfStructs();
+        const int np = pti.numParticles();
 
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-    for (FhdParIter pti(*this, lev); pti.isValid(); ++pti) {
+        auto nbor_data = spc.neighborList(lev, index).data();
+        ParticleType* pstruct = particles().dataPtr();
 
-        const int grid_id = pti.index();
-        const int tile_id = pti.LocalTileIndex();
+        AMREX_FOR_1D( np, i,
+        {
+            const ParticleType& p1 = pstruct[i];
+            const int spec1 = p1.idata(FHD_intData::species)-1;
 
-        auto& particle_tile = GetParticles(lev)[std::make_pair(grid_id,tile_id)];
-        auto& particles = particle_tile.GetArrayOfStructs();
-        const int np = particles.numParticles();
+            // nearest neighbour of each species, last entry for any species
+            Real nearest[MAX_SPECIES+1];
+            for (int n = 0; n <= nspec; ++n) {
+                nearest[n] = 0.;
+            }
 
-        // loop over particles
-        for (int i = 0; i < np; ++i) {
+            for (const auto& p2 : nbor_data.getNeighbors(i))
+            {
+                const Real dx = p1.pos(0) - p2.pos(0);
+                const Real dy = p1.pos(1) - p2.pos(1);
+                const Real dz = p1.pos(2) - p2.pos(2);
+                const Real rad = std::sqrt(dx*dx + dy*dy + dz*dz);
 
-            ParticleType & part = particles[i];
+                if (rad == 0.) continue;
 
-            int iilo = (part.pos(0)-searchDist <= prob_lo[0]) ? -1 : 0;
-            int iihi = (part.pos(0)+searchDist >= prob_hi[0]) ?  1 : 0;
+                const int spec2 = p2.idata(FHD_intData::species)-1;
+                if (nearest[spec2] == 0. || nearest[spec2] > rad) nearest[spec2] = rad;
+                if (nearest[nspec] == 0. || nearest[nspec] > rad) nearest[nspec] = rad;
 
-            int jjlo = (part.pos(1)-searchDist <= prob_lo[1]) ? -1 : 0;
-            int jjhi = (part.pos(1)+searchDist >= prob_hi[1]) ?  1 : 0;
+                if (rad < total_dist) {
+                    const int bin = (int)amrex::Math::floor(rad/bin_size);
+                    Gpu::Atomic::Add(&pacc[(spec1*nspec + spec2)*nbins + bin], 1.);
+                }
+            }
 
-            int kklo = (part.pos(2)-searchDist <= prob_lo[2]) ? -1 : 0;
-            int kkhi = (part.pos(2)+searchDist >= prob_hi[2]) ?  1 : 0;
+            // a species with no member inside the list reach has no nearest
+            // neighbour here; only count the particles that found one
+            for (int n = 0; n < nspec; ++n) {
+                if (nearest[n] > 0.) {
+                    Gpu::Atomic::Add(&pacc[nn_off + spec1*nspec + n], nearest[n]);
+                    Gpu::Atomic::Add(&pacc[nc_off + spec1*nspec + n], 1.);
+                }
+            }
+            if (nearest[nspec] > 0.) {
+                Gpu::Atomic::Add(&pacc[nn_off + nspec*nspec], nearest[nspec]);
+                Gpu::Atomic::Add(&pacc[nc_off + nspec*nspec], 1.);
+            }
+            Gpu::Atomic::Add(&pacc[sc_off + spec1], 1.);
+        });
+    }
 
-            double rad, dx, dy, dz;
+    Gpu::HostVector<Real> acc_h(acc.size());
+    Gpu::copy(Gpu::deviceToHost, acc_d.begin(), acc_d.end(), acc_h.begin());
+    Gpu::streamSynchronize();
 
-            int id = part.id() - 1;
+    for (int n = 0; n < (int)acc.size(); ++n) {
+        acc[n] += acc_h[n];
+    }
+}
 
-            // loop over other particles
-            for(int j = 0; j < totalParticles; j++) {
+// g(x), g(y), g(z) hit counts per species pair from the neighbor list of each particle;
+// acc holds nspecies*nspecies histograms of totalBins for x, then y, then z, followed by
+// the nspecies particle counts; the caller does the reduction
+void FhdParticleContainer::CartesianDistributionNL(RealVector& acc)
+{
+    BL_PROFILE_VAR("CartesianDistributionNL()",CartesianDistributionNL);
 
-                // assume triply periodic, check the domain and the 8 periodic images
-                for(int ii = iilo; ii <= iihi; ii++) {
-                for(int jj = jjlo; jj <= jjhi; jj++) {
-                for(int kk = kklo; kk <= kkhi; kk++) {
+    const int lev = 0;
 
-                    // get distance between particles
-                    dx = part.pos(0)-posx[j] - ii*domx;
-                    dy = part.pos(1)-posy[j] - jj*domy;
-                    dz = part.pos(2)-posz[j] - kk*domz;
+    const int nbins = totalBins;
+    const Real bin_size = binSize;
+    const Real total_dist = totalBins*binSize;
+    const Real search_dist = searchDist;
+    const int nspec = nspecies;
+    const int sc_off = 3*nspec*nspec*nbins;
 
-                    int jSpec = species[j]-1;
-                    rad = sqrt(dx*dx + dy*dy + dz*dz);
+    FhdStatsContainer& spc = UpdateNeighborListForStats(amrex::max(total_dist,search_dist));
 
-                    if((nearest[id*(nspecies+1) + jSpec] == 0 || nearest[id*(nspecies+1) + jSpec] > rad) && rad != 0)
-                    {
-                        nearest[id*(nspecies +1)+ jSpec] = rad;
-                    }
+    Gpu::DeviceVector<Real> acc_d(acc.size(), 0.);
+    Real* pacc = acc_d.dataPtr();
 
-                    if((nearest[id*(nspecies+1) + nspecies] == 0 || nearest[id*(nspecies+1) + nspecies] > rad) && rad != 0)
-                    {
-                        nearest[id*(nspecies +1) + nspecies] = rad;
-//                        Print() << "Particle " << i << " species " << jSpec << ", " << nearest[i*nspecies + jSpec] << "\n";
-                    }
+    for (FhdParIter pti(spc, lev, MFItInfo().SetDynamic(false)); pti.isValid(); ++pti)
+    {
+        PairIndex index(pti.index(), pti.LocalTileIndex());
+        AoS& particles = pti.GetArrayOfStructs();
+        const int np = pti.numParticles();
 
-                    // if particles are close enough, increment the bin
-                    if(rad < totalDist && rad > 0.) {
+        auto nbor_data = spc.neighborList(lev, index).data();
+        ParticleType* pstruct = particles().dataPtr();
+
+        AMREX_FOR_1D( np, i,
+        {
+            const ParticleType& p1 = pstruct[i];
+            const int spec1 = p1.idata(FHD_intData::species)-1;
 
-                        bin = (int)amrex::Math::floor(rad/binSize);
-                        radDist[bin]++;
+            for (const auto& p2 : nbor_data.getNeighbors(i))
+            {
+                Real d[3];
+                d[0] = amrex::Math::abs(p1.pos(0) - p2.pos(0));
+                d[1] = amrex::Math::abs(p1.pos(1) - p2.pos(1));
+                d[2] = amrex::Math::abs(p1.pos(2) - p2.pos(2));
 
-                        if (part.rdata(FHD_realData::q) > 0) {
-                            if (charge[j] > 0) {
-                                radDist_pp[bin]++;
-                            }
-                            else if (charge[j] < 0) {
-                                radDist_pm[bin]++;
-                            }
-                        }
-                        else if (part.rdata(FHD_realData::q) < 0) {
-                            if (charge[j] > 0) {
-                                radDist_pm[bin]++;
-                            }
-                            else if (charge[j] < 0) {
-                                radDist_mm[bin]++;
-                            }
-                        }
+                if (d[0]*d[0] + d[1]*d[1] + d[2]*d[2] == 0.) continue;
+
+                const int spec2 = p2.idata(FHD_intData::species)-1;
+
+                for (int dir = 0; dir < 3; ++dir) {
+                    if (d[dir] < total_dist &&
+                        d[(dir+1)%3] < search_dist && d[(dir+2)%3] < search_dist) {
+
+                        const int bin = (int)amrex::Math::floor(d[dir]/bin_size);
+                        Gpu::Atomic::Add(&pacc[((dir*nspec + spec1)*nspec + spec2)*nbins + bin], 1.);
                     }
                 }
-                }
-                }
-            }  // loop over j (total particles)
-        } // loop over i (np; local particles)
-    }
-
-    // compute total number density
-    double n0_total = 0.;
-    for (int i=0; i<nspecies; ++i) {
-        n0_total += particleInfo[i].n0;
+            }
+            Gpu::Atomic::Add(&pacc[sc_off + spec1], 1.);
+        });
     }
 
-    // collect the hit count
-    ParallelDescriptor::ReduceRealSum(radDist   .dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(radDist_pp.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(radDist_pm.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(radDist_mm.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(nearest,(nspecies+1)*totalParticles);
+    Gpu::HostVector<Real> acc_h(acc.size());
+    Gpu::copy(Gpu::deviceToHost, acc_d.begin(), acc_d.end(), acc_h.begin());
+    Gpu::streamSynchronize();
 
-    int specCount[nspecies];
-
-    for(int i=0;i<nspecies;i++)
-    {
-        specCount[i] = 0;
+    for (int n = 0; n < (int)acc.size(); ++n) {
+        acc[n] += acc_h[n];
     }
+}
 
-    for(int i=0;i<totalParticles;i++)
-    {
-        int iSpec = species[i]-1;
+// charge class of a species pair for the ++, +- and -- distributions:
+// 1 = ++, 2 = +- or -+, 3 = --, 0 = a neutral species
+static int ChargePairClass(const species* particleInfo, const int i, const int j)
+{
+    const Real qi = particleInfo[i].q;
+    const Real qj = particleInfo[j].q;
+    if (qi > 0 && qj > 0) return 1;
+    if ((qi > 0 && qj < 0) || (qi < 0 && qj > 0)) return 2;
+    if (qi < 0 && qj < 0) return 3;
+    return 0;
+}
 
-        specCount[iSpec]++;
+void FhdParticleContainer::RadialDistribution(long totalParticles, const int step, const species* particleInfo)
+{
+    BL_PROFILE_VAR("RadialDistribution()",RadialDistribution);
 
-        for(int j=0;j<nspecies;j++)
-        {
-            nn[(iSpec)*nspecies + j] = nn[(iSpec)*nspecies + j] + nearest[i*(nspecies+1)+j];
+    Print() << "Calculating radial distribution\n";
 
-            //std::cout << (iSpec)*nspecies + j  << ", " << nearest[i*(nspecies+1)+j] << "\n";
+    const int npairs = nspecies*nspecies;
 
-        }
+    // hit counts per species pair, then the nearest neighbour sums per species pair
+    // (plus any species) and the number of particles contributing to each, then the
+    // particle count per species; reduced in one call
+    const int nn_off = npairs*totalBins;
+    const int nc_off = nn_off + npairs + 1;
+    const int sc_off = nc_off + npairs + 1;
+    RealVector acc(sc_off + nspecies, 0.);
 
-        nn[nspecies*nspecies] = nn[nspecies*nspecies] + nearest[i*(nspecies+1)+nspecies];
+    RadialDistributionNL(acc);
+
+    // compute total number density
+    double n0_total = 0.;
+    for (int i=0; i<nspecies; ++i) {
+        n0_total += particleInfo[i].n0;
     }
 
-    for(int i=0;i<nspecies;i++)
-    {
-        for(int j=0;j<nspecies;j++)
-        {
-            if(i==j)
-            {
-                nn[i*nspecies+j] = nn[i*nspecies+j]/(specCount[i]-1);
-            }else
-            {
-                nn[i*nspecies+j] = nn[i*nspecies+j]/specCount[i];
-            }
+    // collect the hit count, nearest neighbour sums and species counts
+    ParallelDescriptor::ReduceRealSum(acc.dataPtr(),acc.size());
 
-            //Print() << nn[i*nspecies+j] << "\n";
+    RealVector nn(acc.begin()+nn_off, acc.begin()+nc_off);
+    RealVector nnCount(acc.begin()+nc_off, acc.begin()+sc_off);
 
+    Vector<Real> specCount(acc.begin()+sc_off, acc.end());
+
+    // all, ++, +- and -- hit counts are sums of the species pair histograms
+    RealVector radDist   (totalBins, 0.);
+    RealVector radDist_pp(totalBins, 0.);
+    RealVector radDist_pm(totalBins, 0.);
+    RealVector radDist_mm(totalBins, 0.);
+    for(int i=0;i<nspecies;i++) {
+        for(int j=0;j<nspecies;j++) {
+            const Real* hits = &acc[(i*nspecies+j)*totalBins];
+            const int qclass = ChargePairClass(particleInfo,i,j);
+            for(int b=0;b<totalBins;b++) {
+                radDist[b] += hits[b];
+                if (qclass == 1) radDist_pp[b] += hits[b];
+                if (qclass == 2) radDist_pm[b] += hits[b];
+                if (qclass == 3) radDist_mm[b] += hits[b];
+            }
         }
     }
 
-    nn[nspecies*nspecies] = nn[nspecies*nspecies]/(totalParticles - 1);
-
-    //Print() << nn[nspecies*nspecies+1] << "\n";
-
+    // the neighbor list only sees neighbours within its reach, so average
+    // over the particles that found one
+    for(int i=0;i<npairs+1;i++)
+    {
+        nn[i] = (nnCount[i] > 0.) ? nn[i]/nnCount[i] : 0.;
+    }
 
     // normalize by 1 / (number density * bin volume * total particle count)
     for(int i=0;i<totalBins;i++) {
@@ -1282,6 +1370,17 @@ void FhdParticleContainer::RadialDistribution(long totalParticles, const int ste
         radDist_mm[i] *= 1./(n0_total*binVolRadial[i]*(double)totalParticles);
     }
 
+    // g_ij(r): normalize by 1 / (number density of j * bin volume * particle count of i)
+    RealVector radDist_ij(acc.begin(), acc.begin()+nn_off);
+    for(int i=0;i<nspecies;i++) {
+        for(int j=0;j<nspecies;j++) {
+            for(int b=0;b<totalBins;b++) {
+                Real& g = radDist_ij[(i*nspecies+j)*totalBins+b];
+                g = (specCount[i] > 0.) ? g/(particleInfo[j].n0*binVolRadial[b]*specCount[i]) : 0.;
+            }
+        }
+    }
+
     // increment number of snapshots
     radialStatsCount++;
     int stepsminusone = radialStatsCount - 1;
@@ -1294,6 +1393,9 @@ void FhdParticleContainer::RadialDistribution(long totalParticles, const int ste
         meanRadialDistribution_pm[i] = (meanRadialDistribution_pm[i]*stepsminusone + radDist_pm[i])*stepsinv;
         meanRadialDistribution_mm[i] = (meanRadialDistribution_mm[i]*stepsminusone + radDist_mm[i])*stepsinv;
     }
+    for(int i=0;i<npairs*totalBins;i++) {
+        meanRadialDistribution_ij[i] = (meanRadialDistribution_ij[i]*stepsminusone + radDist_ij[i])*stepsinv;
+    }
 
     for(int i=0;i<(nspecies*nspecies + 1);i++) {
 
@@ -1302,6 +1404,7 @@ void FhdParticleContainer::RadialDistribution(long totalParticles, const int ste
     }
 
     // output mean radial distribution g(r) based on plot_int
+    // columns: r, all, ++, +-, --, then g_ij for i, j = 1..nspecies
     if (plot_int > 0 && step%plot_int == 0) {
 
         if(ParallelDescriptor::MyProc() == 0) {
@@ -1315,7 +1418,11 @@ void FhdParticleContainer::RadialDistribution(long totalParticles, const int ste
                     << meanRadialDistribution   [i] << " "
                     << meanRadialDistribution_pp[i] << " "
                     << meanRadialDistribution_pm[i] << " "
-                    << meanRadialDistribution_mm[i] << std::endl;
+                    << meanRadialDistribution_mm[i];
+                for(int ij=0;ij<npairs;ij++) {
+                    ofs << " " << meanRadialDistribution_ij[ij*totalBins+i];
+                }
+                ofs << std::endl;
             }
             ofs.close();
         }
@@ -1352,6 +1459,9 @@ void FhdParticleContainer::RadialDistribution(long totalParticles, const int ste
             meanRadialDistribution_pm[i] = 0;
             meanRadialDistribution_mm[i] = 0;
         }
+        for(int i=0;i<npairs*totalBins;i++) {
+            meanRadialDistribution_ij[i] = 0;
+        }
 
         for(int i=0;i<nspecies*nspecies;i++) {
             nearestN[i] = 0;
@@ -1450,164 +1560,16 @@ void FhdParticleContainer::CartesianDistribution(long totalParticles, const int
 {
     BL_PROFILE_VAR("CartesianDistribution()",CartesianDistribution);
 
-    const int lev = 0;
-    int bin;
-    double domx, domy, domz, totalDist; [[maybe_unused]] double temp;
-
-    domx = (prob_hi[0] - prob_lo[0]);
-    domy = (prob_hi[1] - prob_lo[1]);
-    domz = (prob_hi[2] - prob_lo[2]);
-
-    Real posx[totalParticles];
-    Real posy[totalParticles];
-    Real posz[totalParticles];
-
-    Real charge[totalParticles];
-
     Print() << "Calculating Cartesian distribution\n";
 
-    // collect particle positions onto one processor
-    PullDown(0, posx, -1, totalParticles);
-    PullDown(0, posy, -2, totalParticles);
-    PullDown(0, posz, -3, totalParticles);
-    PullDown(0, charge, 27, totalParticles);
-
-    // outer extent
-    totalDist = totalBins*binSize;
-
-    // this is the bin "hit count"
-    RealVector XDist   (totalBins, 0.);
-    RealVector XDist_pp(totalBins, 0.);
-    RealVector XDist_pm(totalBins, 0.);
-    RealVector XDist_mm(totalBins, 0.);
-    RealVector YDist   (totalBins, 0.);
-    RealVector YDist_pp(totalBins, 0.);
-    RealVector YDist_pm(totalBins, 0.);
-    RealVector YDist_mm(totalBins, 0.);
-    RealVector ZDist   (totalBins, 0.);
-    RealVector ZDist_pp(totalBins, 0.);
-    RealVector ZDist_pm(totalBins, 0.);
-    RealVector ZDist_mm(totalBins, 0.);
-
-#ifdef _OPENMP
-#pragma omp parallel
-#endif
-    for (FhdParIter pti(*this, lev); pti.isValid(); ++pti) {
-
-        const int grid_id = pti.index();
-        const int tile_id = pti.LocalTileIndex();
-
-        auto& particle_tile = GetParticles(lev)[std::make_pair(grid_id,tile_id)];
-        auto& particles = particle_tile.GetArrayOfStructs();
-        const int np = particles.numParticles();
+    const int npairs = nspecies*nspecies;
 
-        // loop over particles
-        for (int i = 0; i < np; ++i) {
-
-            ParticleType & part = particles[i];
-
-            int iilo = (part.pos(0)-searchDist <= prob_lo[0]) ? -1 : 0;
-            int iihi = (part.pos(0)+searchDist >= prob_hi[0]) ?  1 : 0;
-
-            int jjlo = (part.pos(1)-searchDist <= prob_lo[1]) ? -1 : 0;
-            int jjhi = (part.pos(1)+searchDist >= prob_hi[1]) ?  1 : 0;
-
-            int kklo = (part.pos(2)-searchDist <= prob_lo[2]) ? -1 : 0;
-            int kkhi = (part.pos(2)+searchDist >= prob_hi[2]) ?  1 : 0;
-
-            double dist, dx, dy, dz;
-            // loop over other particles
-            for(int j = 0; j < totalParticles; j++)
-            {
-                // assume triply periodic, check the domain and the 8 periodic images
-                for(int ii = iilo; ii <= iihi; ii++)
-                {
-                for(int jj = jjlo; jj <= jjhi; jj++)
-                {
-                for(int kk = kklo; kk <= kkhi; kk++)
-                {
-                    // get distance between particles
-                    dx = amrex::Math::abs(part.pos(0)-posx[j] - ii*domx);
-                    dy = amrex::Math::abs(part.pos(1)-posy[j] - jj*domy);
-                    dz = amrex::Math::abs(part.pos(2)-posz[j] - kk*domz);
+    // hit counts per species pair for x, then y, then z, then the particle count
+    // per species; reduced in one call
+    const int sc_off = 3*npairs*totalBins;
+    RealVector acc(sc_off + nspecies, 0.);
 
-                    dist = sqrt(dx*dx + dy*dy + dz*dz);
-
-                    // if particles are close enough, increment the bin
-                    if (dist > 0.) {
-                        if(dx < totalDist && dy < searchDist && dz < searchDist) {
-
-                            bin = (int)amrex::Math::floor(dx/binSize);
-                            XDist[bin]++;
-
-                            if (part.rdata(FHD_realData::q) > 0) {
-                                if (charge[j] > 0) {
-                                    XDist_pp[bin]++;
-                                }
-                                else if (charge[j] < 0) {
-                                    XDist_pm[bin]++;
-                                }
-                            }
-                            else if (part.rdata(FHD_realData::q) < 0) {
-                                if (charge[j] > 0) {
-                                    XDist_pm[bin]++;
-                                }
-                                else if (charge[j] < 0) {
-                                    XDist_mm[bin]++;
-                                }
-                            }
-                        }
-                        if(dy < totalDist && dx < searchDist && dz < searchDist) {
-
-                            bin = (int)amrex::Math::floor(dy/binSize);
-                            YDist[bin]++;
-
-                            if (part.rdata(FHD_realData::q) > 0) {
-                                if (charge[j] > 0) {
-                                    YDist_pp[bin]++;
-                                }
-                                else if (charge[j] < 0) {
-                                    YDist_pm[bin]++;
-                                }
-                            }
-                            else if (part.rdata(FHD_realData::q) < 0) {
-                                if (charge[j] > 0) {
-                                    YDist_pm[bin]++;
-                                }
-                                else if (charge[j] < 0) {
-                                    YDist_mm[bin]++;
-                                }
-                            }
-                        }
-                        if(dz < totalDist && dx < searchDist && dy < searchDist) {
-
-                            bin = (int)amrex::Math::floor(dz/binSize);
-                            ZDist[bin]++;
-
-                            if (part.rdata(FHD_realData::q) > 0) {
-                                if (charge[j] > 0) {
-                                    ZDist_pp[bin]++;
-                                }
-                                else if (charge[j] < 0) {
-                                    ZDist_pm[bin]++;
-                                }
-                            }
-                            else if (part.rdata(FHD_realData::q) < 0) {
-                                if (charge[j] > 0) {
-                                    ZDist_pm[bin]++;
-                                }
-                                else if (charge[j] < 0) {
-                                    ZDist_mm[bin]++;
-                                }
-                            }
-                        }
-                    }
-                }
-                }
-                }
-            }
-        }
-    }
+    CartesianDistributionNL(acc);
 
     // compute total number density
     double n0_total = 0.;
@@ -1616,18 +1578,37 @@ void FhdParticleContainer::CartesianDistribution(long totalParticles, const int
     }
 
     // collect the hit count
-    ParallelDescriptor::ReduceRealSum(XDist   .dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(XDist_pp.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(XDist_pm.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(XDist_mm.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(YDist   .dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(YDist_pp.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(YDist_pm.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(YDist_mm.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(ZDist   .dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(ZDist_pp.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(ZDist_pm.dataPtr(),totalBins);
-    ParallelDescriptor::ReduceRealSum(ZDist_mm.dataPtr(),totalBins);
+    ParallelDescriptor::ReduceRealSum(acc.dataPtr(),acc.size());
+
+    Vector<Real> specCount(acc.begin()+sc_off, acc.end());
+
+    // all, ++, +- and -- hit counts (x, y, z) are sums of the species pair histograms
+    Vector<RealVector> dist(12, RealVector(totalBins, 0.));
+    for(int dir=0;dir<3;dir++) {
+        for(int i=0;i<nspecies;i++) {
+            for(int j=0;j<nspecies;j++) {
+                const Real* hits = &acc[((dir*nspecies+i)*nspecies+j)*totalBins];
+                const int qclass = ChargePairClass(particleInfo,i,j);
+                for(int b=0;b<totalBins;b++) {
+                    dist[4*dir][b] += hits[b];
+                    if (qclass > 0) dist[4*dir+qclass][b] += hits[b];
+                }
+            }
+        }
+    }
+
+    RealVector& XDist    = dist[ 0];
+    RealVector& XDist_pp = dist[ 1];
+    RealVector& XDist_pm = dist[ 2];
+    RealVector& XDist_mm = dist[ 3];
+    RealVector& YDist    = dist[ 4];
+    RealVector& YDist_pp = dist[ 5];
+    RealVector& YDist_pm = dist[ 6];
+    RealVector& YDist_mm = dist[ 7];
+    RealVector& ZDist    = dist[ 8];
+    RealVector& ZDist_pp = dist[ 9];
+    RealVector& ZDist_pm = dist[10];
+    RealVector& ZDist_mm = dist[11];
 
     // normalize by 1 / (number density * bin volume * total particle count)
     for(int i=0;i<totalBins;i++) {
@@ -1645,6 +1626,20 @@ void FhdParticleContainer::CartesianDistribution(long totalParticles, const int
         ZDist_mm[i] *= 1./(n0_total*binVolCartesian*(double)totalParticles);
     }
 
+    // g_ij(x), g_ij(y), g_ij(z): normalize by
+    // 1 / (number density of j * bin volume * particle count of i)
+    RealVector dist_ij(acc.begin(), acc.begin()+sc_off);
+    for(int dir=0;dir<3;dir++) {
+        for(int i=0;i<nspecies;i++) {
+            for(int j=0;j<nspecies;j++) {
+                for(int b=0;b<totalBins;b++) {
+                    Real& g = dist_ij[((dir*nspecies+i)*nspecies+j)*totalBins+b];
+                    g = (specCount[i] > 0.) ? g/(particleInfo[j].n0*binVolCartesian*specCount[i]) : 0.;
+                }
+            }
+        }
+    }
+
     // increment number of snapshots
     cartesianStatsCount++;
     int stepsminusone = cartesianStatsCount - 1;
@@ -1665,8 +1660,13 @@ void FhdParticleContainer::CartesianDistribution(long totalParticles, const int
         meanZDistribution_pm[i] = (meanZDistribution_pm[i]*stepsminusone + ZDist_pm[i])*stepsinv;
         meanZDistribution_mm[i] = (meanZDistribution_mm[i]*stepsminusone + ZDist_mm[i])*stepsinv;
     }
+    for(int i=0;i<3*npairs*totalBins;i++) {
+        meanCartesianDistribution_ij[i] = (meanCartesianDistribution_ij[i]*stepsminusone + dist_ij[i])*stepsinv;
+    }
 
     // output mean Cartesian distribution g(x), g(y), g(z) based on plot_int
+    // columns: x, then all, ++, +-, -- for x, y and z, then g_ij for x, y and z
+    // with i, j = 1..nspecies
     if (plot_int > 0 && step%plot_int == 0) {
 
         if(ParallelDescriptor::MyProc() == 0) {
@@ -1687,7 +1687,11 @@ void FhdParticleContainer::CartesianDistribution(long totalParticles, const int
                     << meanZDistribution   [i] << " "
                     << meanZDistribution_pp[i] << " "
                     << meanZDistribution_pm[i] << " "
-                    << meanZDistribution_mm[i] << " " << std::endl;
+                    << meanZDistribution_mm[i] << " ";
+                for(int ij=0;ij<3*npairs;ij++) {
+                    ofs << meanCartesianDistribution_ij[ij*totalBins+i] << " ";
+                }
+                ofs << std::endl;
             }
             ofs.close();
         }
@@ -1717,6 +1721,9 @@ void FhdParticleContainer::CartesianDistribution(long totalParticles, const int
             meanZDistribution_pm[i] = 0;
             meanZDistribution_mm[i] = 0;
         }
+        for(int i=0;i<3*npairs*totalBins;i++) {
+            meanCartesianDistribution_ij[i] = 0;
+        }
     }
 }
 
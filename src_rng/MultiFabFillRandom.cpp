@@ -1,12 +1,133 @@
 #include "common_functions.H"
 
 #include "rng_functions.H"
+#include "rng_functions_K.H"
+
+namespace {
+    // counter-based stream state; only (step, draw) changes during a run,
+    // so nothing beyond the step index has to be checkpointed
+    int  counter_rng_step = 0;
+    int  counter_rng_draw = 0;
+    bool counter_rng_key_set = false;
+    std::uint32_t counter_rng_key = 0;
+
+    std::uint32_t CounterRNGKey ()
+    {
+        if (!counter_rng_key_set) {
+            if (seed > 0) {
+                counter_rng_key = static_cast<std::uint32_t>(seed);
+            } else {
+                // clock-based key, made consistent across ranks
+                int key = static_cast<int>(ParallelDescriptor::second() * 1.e6) & 0x7fffffff;
+                ParallelDescriptor::Bcast(&key, 1, ParallelDescriptor::IOProcessorNumber());
+                counter_rng_key = static_cast<std::uint32_t>(key);
+            }
+            counter_rng_key_set = true;
+        }
+        return counter_rng_key;
+    }
+
+    // distinct draws give distinct keys (multiplication by an odd constant is a bijection)
+    std::uint32_t CounterRNGDrawKey (const int& draw)
+    {
+        return CounterRNGKey() ^ (static_cast<std::uint32_t>(draw) * 0x9E3779B9u);
+    }
+
+    // fill components [scomp,scomp+ncomp) of mf over valid+ng cells with
+    // mean + sA*N_A + sB*N_B, where N_A and N_B are the standard normal streams
+    // of draws drawA and drawB (sB = 0 skips the second stream).  Samples are
+    // addressed by global index, wrapped in periodic directions so faces/nodes
+    // that coincide physically draw the same value.
+    void FillCounterRandomPair (MultiFab& mf, const int& scomp, const int& ncomp,
+                                const Real& mean,
+                                const Real& sA, const int& drawA,
+                                const Real& sB, const int& drawB,
+                                const Geometry& geom, const int& ng)
+    {
+        const std::uint32_t keyA = CounterRNGDrawKey(drawA);
+        const std::uint32_t keyB = CounterRNGDrawKey(drawB);
+        const std::uint32_t key1 = static_cast<std::uint32_t>(counter_rng_step);
+
+        const Box& dom = geom.Domain();
+        GpuArray<int,AMREX_SPACEDIM> dlo, dlen, is_per;
+        for (int d=0; d<AMREX_SPACEDIM; ++d) {
+            dlo[d] = dom.smallEnd(d);
+            dlen[d] = dom.length(d);
+            is_per[d] = geom.isPeriodic(d);
+        }
+
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            const Box& bx = (ng==0) ? mfi.validbox() : mfi.growntilebox(ng);
+            const Array4<Real>& mf_fab = mf.array(mfi);
+            amrex::ParallelFor(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+            {
+                int iv[3] = {i,j,k};
+                for (int d=0; d<AMREX_SPACEDIM; ++d) {
+                    if (is_per[d]) {
+                        iv[d] = dlo[d] + ((iv[d]-dlo[d]) % dlen[d] + dlen[d]) % dlen[d];
+                    }
+                }
+                Real val = mean + sA*CounterRandomNormal(keyA,key1,iv[0],iv[1],iv[2],scomp+n);
+                if (sB != 0.) {
+                    val += sB*CounterRandomNormal(keyB,key1,iv[0],iv[1],iv[2],scomp+n);
+                }
+                mf_fab(i,j,k,scomp+n) = val;
+            });
+        }
+    }
+
+    // single stream on the next draw index
+    void FillCounterRandomNormal (MultiFab& mf, const int& scomp, const int& ncomp,
+                                  const Real& mean, const Real& stddev,
+                                  const Geometry& geom, const int& ng)
+    {
+        const int draw = counter_rng_draw++;
+        FillCounterRandomPair(mf, scomp, ncomp, mean, stddev, draw, 0., draw, geom, ng);
+    }
+}
+
+void CounterRNGSetStep(const int& step)
+{
+    counter_rng_step = step;
+    counter_rng_draw = 0;
+}
+
+int CounterRNGReserveDraws(const int& ndraws)
+{
+    const int first = counter_rng_draw;
+    counter_rng_draw += ndraws;
+    return first;
+}
+
+void MultiFabFillCounterRandomLinComb(MultiFab& mf, const int& scomp, const int& ncomp,
+                                      const amrex::Real& wA, const int& drawA,
+                                      const amrex::Real& wB, const int& drawB,
+                                      const amrex::Real& variance, const Geometry& geom)
+{
+    BL_PROFILE_VAR("MultiFabFillCounterRandomLinComb()",MultiFabFillCounterRandomLinComb);
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(rng_counter_based == 1,
+        "MultiFabFillCounterRandomLinComb requires rng_counter_based = 1");
+
+    const Real stddev = std::sqrt(variance);
+    FillCounterRandomPair(mf, scomp, ncomp, 0., wA*stddev, drawA, wB*stddev, drawB, geom, 0);
+
+    // shared faces/nodes already agree, only ghost cells need filling
+    mf.FillBoundary(scomp, ncomp, geom.periodicity());
+}
 
 void MultiFabFillRandom(MultiFab& mf, const int& comp, const amrex::Real& variance,
                         const Geometry& geom, const int& ng)
 {
     BL_PROFILE_VAR("MultiFabFillRandom()",MultiFabFillRandom);
 
+    if (rng_counter_based == 1) {
+        FillCounterRandomNormal(mf, comp, 1, 0., sqrt(variance), geom, ng);
+        mf.OverrideSync(geom.periodicity());
+        mf.FillBoundary(geom.periodicity());
+        return;
+    }
+
     for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
         const Box& bx = (ng==0) ? mfi.validbox() : mfi.growntilebox(ng);
         const Array4<Real>& mf_fab = mf.array(mfi);
@@ -31,6 +152,45 @@ void MultiFabFillRandom(MultiFab& mf, const int& comp, const amrex::Real& varian
 }
 
 
+void MultiFabFillRandomFused(MultiFab& mf, const int& scomp, const int& ncomp,
+                             const amrex::Real& variance, const Geometry& geom,
+                             bool fillboundary_nowait)
+{
+    BL_PROFILE_VAR("MultiFabFillRandomFused()",MultiFabFillRandomFused);
+
+    const Real stddev = std::sqrt(variance);
+
+    if (rng_counter_based == 1) {
+        // every copy of a shared face/node derives the same sample from its
+        // global index, so the owner value is already in place everywhere
+        FillCounterRandomNormal(mf, scomp, ncomp, 0., stddev, geom, 0);
+    } else {
+        // draw already-scaled samples for all components in one pass
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            const Box& bx = mfi.validbox();
+            const Array4<Real>& mf_fab = mf.array(mfi);
+            amrex::ParallelForRNG(bx, ncomp, [=] AMREX_GPU_DEVICE (int i, int j, int k, int n, amrex::RandomEngine const& engine) noexcept
+            {
+                mf_fab(i,j,k,scomp+n) = amrex::RandomNormal(0.,stddev,engine);
+            });
+        }
+
+        // shared faces/nodes take the owner's value; a no-op for cell-centered data
+        if (!mf.ixType().cellCentered()) {
+            mf.OverrideSync(scomp, ncomp, geom.periodicity());
+        }
+    }
+
+    // one ghost exchange for all components; with fillboundary_nowait the caller
+    // can generate the next field before calling mf.FillBoundary_finish()
+    if (fillboundary_nowait) {
+        mf.FillBoundary_nowait(scomp, ncomp, geom.periodicity());
+    } else {
+        mf.FillBoundary(scomp, ncomp, geom.periodicity());
+    }
+}
+
+
 void MultiFabFillRandomNormal(MultiFab& mf, const int& scomp, const int& ncomp,
                               const amrex::Real& mean, const amrex::Real& variance,
                               const Geometry& geom, bool overridesync, bool fillboundary)
@@ -40,7 +200,11 @@ void MultiFabFillRandomNormal(MultiFab& mf, const int& scomp, const int& ncomp,
     // FillRandomNormal requires standard deviation
     amrex::Real stddev = sqrt(variance);
 
-    FillRandomNormal(mf, scomp, ncomp, mean, stddev);
+    if (rng_counter_based == 1) {
+        FillCounterRandomNormal(mf, scomp, ncomp, mean, stddev, geom, 0);
+    } else {
+        FillRandomNormal(mf, scomp, ncomp, mean, stddev);
+    }
 
     // overridesync
     if (overridesync) mf.OverrideSync(geom.periodicity());
@@ -5,6 +5,8 @@
 
 AMREX_GPU_MANAGED int surfchem_mui::nspec_mui;
 
+int surfchem_mui::mui_lag;
+
 void InitializeSurfChemMUINamespace()
 {
     // extract inputs parameters
@@ -13,6 +15,16 @@ void InitializeSurfChemMUINamespace()
     // number of species involved in mui (via adsorption/desorption)
     pp.get("nspec_mui",nspec_mui);
 
+    // number of steps by which the KMC counts applied to FHD lag behind
+    // 0 = synchronous coupling (FHD waits for the KMC step running concurrently)
+    // n>0 = the counts of step-n are applied at step, so FHD only waits if KMC
+    //       falls more than n steps behind
+    mui_lag = 0;
+    pp.query("mui_lag",mui_lag);
+    if (mui_lag < 0) {
+        Abort("mui_lag must be non-negative");
+    }
+
     return;
 }
 
@@ -41,11 +53,66 @@ void mui_print_MF_bottom(MultiFab& mf,int n,double factor,int step, const char *
     }
 }
 
+// index range (in x and y) of the cells of mf at the interface (k=0) owned by
+// this MPI process; returns false if there are none
+static bool mui_interface_range(const MultiFab& mf, int* rlo, int* rhi)
+{
+    bool found = false;
+
+    for (MFIter mfi(mf,false); mfi.isValid(); ++mfi)
+    {
+        const Box& bx = mfi.tilebox();
+        Dim3 lo = lbound(bx);
+        Dim3 hi = ubound(bx);
+
+        int k = 0;
+        if (k<lo.z || k>hi.z) continue;
+
+        if (!found)
+        {
+            rlo[0] = lo.x; rlo[1] = lo.y;
+            rhi[0] = hi.x; rhi[1] = hi.y;
+            found = true;
+        }
+        else
+        {
+            rlo[0] = amrex::min(rlo[0],lo.x); rlo[1] = amrex::min(rlo[1],lo.y);
+            rhi[0] = amrex::max(rhi[0],hi.x); rhi[1] = amrex::max(rhi[1],hi.y);
+        }
+    }
+
+    return found;
+}
+
+// fetch one channel of KMC counts on the interface cells in [rlo,rhi] with a
+// single pass over the received points (see uniface::fetch_grid)
+static std::vector<int> mui_fetch_channel(mui::uniface2d &uniface, const std::string& channel,
+                                          const int* rlo, const int* rhi, const amrex::Real* dx,
+                                          const int step)
+{
+    mui::chrono_sampler_exact2d t;
+
+    double tmp[2];
+
+    tmp[0] = prob_lo[0] + rlo[0]*dx[0];
+    tmp[1] = prob_lo[1] + rlo[1]*dx[1];
+    point<double,2> plo(tmp);
+
+    tmp[0] = dx[0];
+    tmp[1] = dx[1];
+    point<double,2> h(tmp);
+
+    std::array<std::size_t,2> n = {std::size_t(rhi[0]-rlo[0]+1), std::size_t(rhi[1]-rlo[1]+1)};
+
+    return uniface.fetch_grid<int>(channel,plo,h,n,step,t);
+}
+
 void mui_push(MultiFab& cu, MultiFab& prim, const amrex::Real* dx, mui::uniface2d &uniface, const int step)
 // this routine pushes the following information to MUI
 // - species number densities and temperature of FHD cells contacting the interface
 // it assumes that the interface is perpendicular to the z-axis
 // and includes cells with the smallest value of z (i.e. k=0)
+// each box pushes one array per channel
 {
     for (MFIter mfi(cu,false); mfi.isValid(); ++mfi)
     {
@@ -59,31 +126,50 @@ void mui_push(MultiFab& cu, MultiFab& prim, const amrex::Real* dx, mui::uniface2
         int k = 0;
         if (k<lo.z || k>hi.z) continue;
 
-        for (int i = lo.x; i<=hi.x; ++i)
-        {
-            for (int j = lo.y; j<= hi.y; ++j)
-            {
-                double x = prob_lo[0]+(i+0.5)*dx[0];
-                double y = prob_lo[1]+(j+0.5)*dx[1];
+        const int nx = hi.x-lo.x+1;
+        const int ny = hi.y-lo.y+1;
 
-                std::string channel;
+        double tmp[2];
 
-                for (int n = 0; n < nspec_mui; ++n)
-                {
-                    channel = "CH_density";
-                    channel += '0'+(n+1);   // assuming nspec_mui<10
+        tmp[0] = prob_lo[0]+lo.x*dx[0];
+        tmp[1] = prob_lo[1]+lo.y*dx[1];
+        point<double,2> plo(tmp);
 
-                    double dens = cu_arr(i,j,k,5+n);    // mass density
-                    dens *= AVONUM/molmass[n];          // number density
+        tmp[0] = dx[0];
+        tmp[1] = dx[1];
+        point<double,2> h(tmp);
 
-                    uniface.push(channel,{x,y},dens);
+        std::array<std::size_t,2> n = {std::size_t(nx), std::size_t(ny)};
+
+        std::vector<double> vals(nx*ny);
+
+        for (int m = 0; m < nspec_mui; ++m)
+        {
+            std::string channel = "CH_density";
+            channel += '0'+(m+1);   // assuming nspec_mui<10
+
+            for (int j = lo.y; j<= hi.y; ++j)
+            {
+                for (int i = lo.x; i<=hi.x; ++i)
+                {
+                    double dens = cu_arr(i,j,k,5+m);    // mass density
+                    dens *= AVONUM/molmass[m];          // number density
+                    vals[(i-lo.x)+nx*(j-lo.y)] = dens;
                 }
+            }
+
+            uniface.push_grid(channel,plo,h,n,vals);
+        }
 
-                channel = "CH_temp";
-                double temp = prim_arr(i,j,k,4);
-                uniface.push(channel,{x,y},temp);
+        for (int j = lo.y; j<= hi.y; ++j)
+        {
+            for (int i = lo.x; i<=hi.x; ++i)
+            {
+                vals[(i-lo.x)+nx*(j-lo.y)] = prim_arr(i,j,k,4);
             }
         }
+
+        uniface.push_grid("CH_temp",plo,h,n,vals);
     }
 
     return;
@@ -102,53 +188,52 @@ void mui_fetch(MultiFab& cu, MultiFab& prim, const amrex::Real* dx, mui::uniface
 // it assumes that the interface is perpendicular to the z-axis
 // and includes cells with the smallest value of z (i.e. k=0)
 {
-    mui::sampler_kmc_fhd2d<int> s({dx[0],dx[1]});
-    mui::chrono_sampler_exact2d t;
+    int rlo[2] = {0,0};
+    int rhi[2] = {-1,-1};
 
-    for (MFIter mfi(cu,false); mfi.isValid(); ++mfi)
+    // processes without interface cells still fetch (an empty array)
+    // so that incoming MUI messages are consumed
+    if (!mui_interface_range(cu, rlo, rhi))
     {
-        const Box& bx = mfi.tilebox();
-        Dim3 lo = lbound(bx);
-        Dim3 hi = ubound(bx);
-        const Array4<Real> & cu_arr = cu.array(mfi);
-        const Array4<Real> & prim_arr = prim.array(mfi);
+        mui_fetch_channel(uniface,"CH_ac1",rlo,rhi,dx,step);
+        return;
+    }
 
-        // unless bx contains cells at the interface, skip
-        // ad-hoc fix to avoid memory leakage
-        int k = 0;
-        if (k<lo.z || k>hi.z)
-        {
-            double x = prob_lo[0]+(lo.x+0.5)*dx[0];
-            double y = prob_lo[1]+(lo.y+0.5)*dx[1];
+    const int nx = rhi[0]-rlo[0]+1;
 
-            uniface.fetch("CH_ac1",{x,y},step,s,t);
+    for (int n = 0; n < nspec_mui; ++n)
+    {
+        std::string channel;
 
-            continue;
-        }
+        channel = "CH_ac";
+        channel += '0'+(n+1);   // assuming nspec_mui<10
+        std::vector<int> ac = mui_fetch_channel(uniface,channel,rlo,rhi,dx,step);
 
-        for (int i = lo.x; i<=hi.x; ++i)
-        {
-            for (int j = lo.y; j<= hi.y; ++j)
-            {
-                double x = prob_lo[0]+(i+0.5)*dx[0];
-                double y = prob_lo[1]+(j+0.5)*dx[1];
+        channel = "CH_dc";
+        channel += '0'+(n+1);   // assuming nspec_mui<10
+        std::vector<int> dc = mui_fetch_channel(uniface,channel,rlo,rhi,dx,step);
 
-                for (int n = 0; n < nspec_mui; ++n)
-                {
-                    std::string channel;
-                    int ac,dc;
+        for (MFIter mfi(cu,false); mfi.isValid(); ++mfi)
+        {
+            const Box& bx = mfi.tilebox();
+            Dim3 lo = lbound(bx);
+            Dim3 hi = ubound(bx);
+            const Array4<Real> & cu_arr = cu.array(mfi);
+            const Array4<Real> & prim_arr = prim.array(mfi);
 
-                    channel = "CH_ac";
-                    channel += '0'+(n+1);   // assuming nspec_mui<10
-                    ac = uniface.fetch(channel,{x,y},step,s,t);
+            // unless bx contains cells at the interface, skip
+            int k = 0;
+            if (k<lo.z || k>hi.z) continue;
 
-                    channel = "CH_dc";
-                    channel += '0'+(n+1);   // assuming nspec_mui<10
-                    dc = uniface.fetch(channel,{x,y},step,s,t);
+            for (int i = lo.x; i<=hi.x; ++i)
+            {
+                for (int j = lo.y; j<= hi.y; ++j)
+                {
+                    const int c = (i-rlo[0]) + nx*(j-rlo[1]);
 
                     // update
 
-                    amrex::Real dN = ac-dc;
+                    amrex::Real dN = ac[c]-dc[c];
                     amrex::Real T_inst = prim_arr(i,j,k,4);
                     amrex::Real factor1 = molmass[n]/AVONUM/(dx[0]*dx[1]*dx[2]);
                     amrex::Real factor2 = (BETA*k_B*T_inst+(e0[n]+hcv[n]*T_inst)*molmass[n]/AVONUM)/(dx[0]*dx[1]*dx[2]);
@@ -166,8 +251,20 @@ void mui_fetch(MultiFab& cu, MultiFab& prim, const amrex::Real* dx, mui::uniface
 
 void mui_fetch_Ntot(MultiFab& Ntot, const amrex::Real* dx, mui::uniface2d &uniface, const int step)
 {
-    mui::sampler_kmc_fhd2d<int> s({dx[0],dx[1]});
-    mui::chrono_sampler_exact2d t;
+    int rlo[2] = {0,0};
+    int rhi[2] = {-1,-1};
+
+    // unless this process owns part of the bottom layer, there is nothing to update
+    // however, incoming MUI messages still need to be consumed
+    if (!mui_interface_range(Ntot, rlo, rhi))
+    {
+        mui_fetch_channel(uniface,"CH_one",rlo,rhi,dx,step);
+        return;
+    }
+
+    const int nx = rhi[0]-rlo[0]+1;
+
+    std::vector<int> one = mui_fetch_channel(uniface,"CH_one",rlo,rhi,dx,step);
 
     for (MFIter mfi(Ntot,false); mfi.isValid(); ++mfi)
     {
@@ -176,28 +273,15 @@ void mui_fetch_Ntot(MultiFab& Ntot, const amrex::Real* dx, mui::uniface2d &unifa
         Dim3 hi = ubound(bx);
         const Array4<Real> & Ntot_arr = Ntot.array(mfi);
 
-        // unless bx contains the bottom layer, there is nothing to update
-        // however, to avoid memory leakage, we do an ad-hoc fix
         int k = 0;
-        if (k<lo.z || k>hi.z)
-        {
-            double x = prob_lo[0]+(lo.x+0.5)*dx[0];
-            double y = prob_lo[1]+(lo.y+0.5)*dx[1];
-
-            uniface.fetch("CH_one",{x,y},step,s,t);
-
-            continue;
-        }
+        if (k<lo.z || k>hi.z) continue;
 
         // if bx contains the bottom layer, need to update Ntot
         for (int i = lo.x; i<=hi.x; ++i)
         {
             for (int j = lo.y; j<= hi.y; ++j)
             {
-                double x = prob_lo[0]+(i+0.5)*dx[0];
-                double y = prob_lo[1]+(j+0.5)*dx[1];
-
-                Ntot_arr(i,j,k,0) = uniface.fetch("CH_one",{x,y},step,s,t);
+                Ntot_arr(i,j,k,0) = one[(i-rlo[0]) + nx*(j-rlo[1])];
 
                 AllPrint() << "Ntot(" << i << "," << j << ")= " << Ntot_arr(i,j,k,0) << "\n";
             }
@@ -212,48 +296,46 @@ void mui_fetch_surfcov(MultiFab& Ntot, MultiFab& surfcov, const amrex::Real* dx,
     // reset surfcov to zero
     surfcov.setVal(0.);
 
-    mui::sampler_kmc_fhd2d<int> s({dx[0],dx[1]});
-    mui::chrono_sampler_exact2d t;
+    int rlo[2] = {0,0};
+    int rhi[2] = {-1,-1};
 
-    for (MFIter mfi(surfcov,false); mfi.isValid(); ++mfi)
+    // unless this process owns part of the bottom layer, there is nothing to update
+    // however, incoming MUI messages still need to be consumed
+    if (!mui_interface_range(surfcov, rlo, rhi))
     {
-        const Box& bx = mfi.tilebox();
-        Dim3 lo = lbound(bx);
-        Dim3 hi = ubound(bx);
-        const Array4<Real> & surfcov_arr = surfcov.array(mfi);
-        const Array4<Real> & Ntot_arr = Ntot.array(mfi);
+        mui_fetch_channel(uniface,"CH_occ1",rlo,rhi,dx,step);
+        return;
+    }
 
-        // unless bx contains the bottom layer, there is nothing to update
-        // however, to avoid memory leakage, we do an ad-hoc fix
-        int k = 0;
-        if (k<lo.z || k>hi.z)
-        {
-            double x = prob_lo[0]+(lo.x+0.5)*dx[0];
-            double y = prob_lo[1]+(lo.y+0.5)*dx[1];
+    const int nx = rhi[0]-rlo[0]+1;
 
-            uniface.fetch("CH_occ1",{x,y},step,s,t);
+    // to compute surfcov for each species
+    // get the number of sites occupied by the species
+    for (int n = 0; n < nspec_mui; ++n)
+    {
+        std::string channel;
 
-            continue;
-        }
+        channel = "CH_occ";
+        channel += '0'+(n+1);   // assuming nspec_mui<10
+        std::vector<int> Nocc = mui_fetch_channel(uniface,channel,rlo,rhi,dx,step);
 
-        // if bx contains the bottom layer, need to update surfcov
-        for (int i = lo.x; i<=hi.x; ++i)
+        for (MFIter mfi(surfcov,false); mfi.isValid(); ++mfi)
         {
-            for (int j = lo.y; j<= hi.y; ++j)
-            {
-                double x = prob_lo[0]+(i+0.5)*dx[0];
-                double y = prob_lo[1]+(j+0.5)*dx[1];
+            const Box& bx = mfi.tilebox();
+            Dim3 lo = lbound(bx);
+            Dim3 hi = ubound(bx);
+            const Array4<Real> & surfcov_arr = surfcov.array(mfi);
+            const Array4<Real> & Ntot_arr = Ntot.array(mfi);
 
-                // to compute surfcov for each species
-                // get the number of sites occupied by the species
-                for (int n = 0; n < nspec_mui; ++n)
-                {
-                    std::string channel;
+            int k = 0;
+            if (k<lo.z || k>hi.z) continue;
 
-                    channel = "CH_occ";
-                    channel += '0'+(n+1);   // assuming nspec_mui<10
-                    int Nocc = uniface.fetch(channel,{x,y},step,s,t);
-                    surfcov_arr(i,j,k,n) = Nocc/Ntot_arr(i,j,k,0);
+            // if bx contains the bottom layer, need to update surfcov
+            for (int i = lo.x; i<=hi.x; ++i)
+            {
+                for (int j = lo.y; j<= hi.y; ++j)
+                {
+                    surfcov_arr(i,j,k,n) = Nocc[(i-rlo[0]) + nx*(j-rlo[1])]/Ntot_arr(i,j,k,0);
                 }
             }
         }